@@ -13,8 +13,9 @@
  * application.
  */
 Application::Application( Config config, int appID, 
-    std::list<std::string> operations )
-    :   m_config( config ), m_appID( appID ), m_operations( operations )
+    std::list<Operation> operations )
+    :   m_config( config ), m_appID( appID ), 
+        m_operations( std::move( operations ) )
 {
     calculateApplicationTime();
 }
@@ -33,31 +34,29 @@ void Application::start()
         << m_appID << "\n";
 
     // Executes each operation within this Application
-    std::list<std::string>::iterator iter = m_operations.begin();
+    std::list<Operation>::iterator iter = m_operations.begin();
     while( !( m_operations.empty() ) )
     {
-        // Splits the operation into it's component pieces
-        std::map<std::string, std::string> operation = Parser::splitOperation( 
-            *iter );
-        int runningTime = calculateOperationTime( operation );
+        // Operations were parsed and timed when this application was built
+        const Operation& operation = *iter;
 
         // Execute process
-        if( operation["Component"] == "P" )
+        if( operation.Component == 'P' )
         {
-            runProcess( runningTime );
+            runProcess( operation.RunningTime );
         }
         // Execute input within it's own thread
-        else if( operation["Component"] == "I" )
+        else if( operation.Component == 'I' )
         {
             std::thread inputThread( &Application::runInput, this, 
-                operation["Operation"], runningTime );
+                operation.Name, operation.RunningTime );
             inputThread.join();
         }
         // Execute output within it's own thread
-        else if( operation["Component"] == "O" )
+        else if( operation.Component == 'O' )
         {
             std::thread outputThread( &Application::runOutput, this, 
-                operation["Operation"], runningTime );
+                operation.Name, operation.RunningTime );
             outputThread.join();
         }
         
@@ -143,20 +142,19 @@ void Application::runOutput( std::string name, int runningTime )
 //
 
 /**
- * @brief      Sets this application's ApplicationTime to the total time of all
- * operations within this Application.
+ * @brief      Sets each operation's RunningTime, and this application's
+ * ApplicationTime to the total time of all operations within this Application.
  */
 void Application::calculateApplicationTime()
 {
     ApplicationTime = 0;
     // Iterates through the list of operations, adds each operation's
     // running time to the total running time
-    for( std::list<std::string>::const_iterator iter = m_operations.begin();
+    for( std::list<Operation>::iterator iter = m_operations.begin();
          iter != m_operations.end(); ++iter )
     {
-        std::map<std::string, std::string> operation = Parser::splitOperation( 
-            *iter );
-        ApplicationTime += calculateOperationTime( operation );
+        iter->RunningTime = calculateOperationTime( *iter );
+        ApplicationTime += iter->RunningTime;
     }
 }
 
@@ -167,34 +165,31 @@ void Application::calculateApplicationTime()
  *
  * @return     The time this operation will take in milliseconds.
  */
-int Application::calculateOperationTime( 
-    std::map<std::string, std::string> operation )
+int Application::calculateOperationTime( const Operation& operation )
 {
-    // Parse the cycle time to an int
-    int cycleTime = std::stoi( operation["Cycle"] );
+    int cycleTime = operation.Cycles;
 
     // Return a process' cycle time
-    if( operation["Component"] == "P" )
+    if( operation.Component == 'P' )
     {
         return cycleTime * m_config.processorCycle;
     }
     // Return an input's / output's cycle time
-    else if( operation["Component"] == "I" ||
-             operation["Component"] == "O")
+    else if( operation.Component == 'I' || operation.Component == 'O' )
     {
-        if( operation["Operation"] == "hard drive" )
+        if( operation.Name == "hard drive" )
         {
             return cycleTime * m_config.hardDriveCycle;
         }
-        else if ( operation["Operation"] == "keyboard" )
+        else if ( operation.Name == "keyboard" )
         {
             return cycleTime * m_config.keyboardCycle;
         }
-        else if ( operation["Operation"] == "monitor" )
+        else if ( operation.Name == "monitor" )
         {
             return cycleTime * m_config.monitorDisplayCycle;
         }
-        else if ( operation["Operation"] == "printer" )
+        else if ( operation.Name == "printer" )
         {
             return cycleTime * m_config.printerCycle;
         }
@@ -234,10 +229,11 @@ std::ostream& operator<<( std::ostream& os, const Application& app )
 {
     os << "[Application " << app.m_appID << "]" << std::endl;
     // Prints out all the operations on a newline within the application
-    for( std::list<std::string>::const_iterator iter = app.m_operations.begin();
+    for( std::list<Operation>::const_iterator iter = app.m_operations.begin();
          iter != app.m_operations.end(); ++iter )
     {
-        os << *iter << std::endl;
+        os << iter->Component << "(" << iter->Name << ")" << iter->Cycles 
+            << std::endl;
     }
     os << "[Application " << app.m_appID << "]" << std::endl;
     return os;
@@ -6,16 +6,19 @@
 #include <map>
 #include <thread>
 #include <chrono>
+#include <utility>
 
 #include "Tools/log.h"
 #include "Tools/config.h"
 #include "Tools/parser.h"
 #include "Tools/timer.h"
 
+#include "operation.h"
+
 class Application
 {
 public:
-    Application( Config config, int appID, std::list<std::string> operations );
+    Application( Config config, int appID, std::list<Operation> operations );
 
     void start();
 
@@ -26,11 +29,11 @@ private:
     void runOutput( std::string name, int cycleTime );
 
     void calculateApplicationTime();
-    int calculateOperationTime( std::map<std::string, std::string> operation );
+    int calculateOperationTime( const Operation& operation );
 
     Config m_config;
     int m_appID;
-    std::list<std::string> m_operations;
+    std::list<Operation> m_operations;
 
     friend bool operator<( const Application& app1, const Application& app2 );
     friend std::ostream& operator<<( std::ostream& os, const Application& app );
@@ -0,0 +1,18 @@
+#ifndef OPERATION_H
+#define OPERATION_H
+
+#include <string>
+
+/**
+ * @brief      A meta-data operation of an application, parsed once when the
+ * simulator builds the application.
+ */
+struct Operation
+{
+    char Component;
+    std::string Name;
+    int Cycles;
+    int RunningTime;
+};
+
+#endif  //  OPERATION_H
@@ -67,50 +67,81 @@ void Simulator::start()
  *
  * @param[in]  operations  The full list of operations to build from.
  */
-void Simulator::buildFIFO( std::list<std::string> operations )
+void Simulator::buildFIFO( const std::list<std::string>& operations )
 {
     // Give each application a unique ID
     int appID = 0;
 
     // Builds the simulator's operations by creating applications
     // that contains their own operations
-    std::list<std::string>::iterator operationsIter = operations.begin();
-    while( !( operations.empty() ) )
+    OperationRecord record;
+    std::list<std::string>::const_iterator operationsIter = 
+        operations.begin();
+    while( operationsIter != operations.end() )
     {
-        std::map<std::string, std::string> operation = Parser::splitOperation(
-            *operationsIter );
         // If the operation is an Application, extract the operations and give it to
         // the operation until that application's section is over
-        if( operation["Component"] == "A" && operation["Operation"] == "start" )
+        if( parse( *operationsIter, record ) && record.Component == 'A' && 
+            Parser::isNamed( *operationsIter, record, "start" ) )
         {
             appID++;
-            // Removes "Application Start"
-            operations.erase( operationsIter++ );
+            // Skips "Application Start"
+            ++operationsIter;
 
-            // Create a temp list for all of the app's operations
-            std::list<std::string> applicationOperations;
+            // Create a temp list for all of the app's operations, each parsed
+            // once here rather than every time the application reads it
+            std::list<Operation> applicationOperations;
 
-            operation = Parser::splitOperation( *operationsIter );
             // Add each operation until the app's section ends
-            while( operation["Component"] != "A" && 
-                   operation["Operation"] != "stop" )
+            for( ; operationsIter != operations.end(); ++operationsIter )
             {
-                applicationOperations.push_back( *operationsIter );
-                operations.erase( operationsIter++ );
-                operation = Parser::splitOperation( *operationsIter );
+                if( !( parse( *operationsIter, record ) ) )
+                    continue;
+                if( record.Component == 'A' || 
+                    Parser::isNamed( *operationsIter, record, "stop" ) )
+                {
+                    break;
+                }
+                Operation operation = { record.Component, 
+                    Parser::nameOf( *operationsIter, record ), record.Cycles, 
+                    0 };
+                applicationOperations.push_back( operation );
             }
 
             // Create the new application with the extracted operations
-            Application app( m_config, appID, applicationOperations );
+            Application app( m_config, appID, 
+                std::move( applicationOperations ) );
             // Give it to the simulator's application list
-            m_applications.push_back( app );
+            m_applications.push_back( std::move( app ) );
+
+            if( operationsIter == operations.end() )
+                break;
         }
-        // Removes "Simulation End" or any operations that do not belong
+        // Skips "Simulation End" or any operations that do not belong
         // to any application 
-        operations.erase( operationsIter++ );
+        ++operationsIter;
     }
 }
 
+/**
+ * @brief      Parses one meta-data operation, reporting it if it is malformed.
+ *
+ * @param[in]  operation  The operation as written, such as "P(run)6".
+ * @param[out] record     The parsed operation.
+ *
+ * @return     True if the operation is well formed, false if it should be
+ * skipped.
+ */
+bool Simulator::parse( const std::string& operation, OperationRecord& record )
+{
+    if( Parser::parseOperation( operation, record ) )
+        return true;
+
+    std::cout << "WARNING: Skipping malformed operation \"" << operation 
+        << "\", " << record.Error << "." << std::endl;
+    return false;
+}
+
 /**
  * @brief      Builds the Shortest Job First scheduling code.
  * @note       Currently also used to perform SRTF-N since all it does is
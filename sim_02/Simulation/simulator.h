@@ -19,8 +19,9 @@ public:
     void start();
 
 private:
-    void buildFIFO( std::list<std::string> operations );
+    void buildFIFO( const std::list<std::string>& operations );
     void buildSJF();
+    static bool parse( const std::string& operation, OperationRecord& record );
     void printApplications();
 
     Config m_config;
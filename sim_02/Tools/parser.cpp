@@ -1,5 +1,7 @@
 #include "parser.h"
 
+#include <limits>
+
 //
 // LOAD FILES //////////////////////////////////////////////////////////////////
 //
@@ -112,67 +114,122 @@ std::list<std::string> Parser::splitMetaData( std::string metadata )
 {
     // Remove the first line (contains "Start Program Meta-Data Code:")
     metadata.erase( 0, metadata.find( '\n' ) + 1 );
-    // Remove all new line characters
-    metadata.erase( 
-        std::remove( metadata.begin(), metadata.end(), '\n' ), metadata.end() );
+    // The last operation ends with "." instead of a ";"
+    size_t end = std::min( metadata.find( '.' ), metadata.size() );
 
-    size_t pos = 0;
-    std::string token;
+    const char* space = " \t\r\n";
+    size_t start = 0;
     std::list<std::string> tokens;
-    std::string delimiter = "; ";
-    // Grab all the operations ending with ";"
-    while( ( pos = metadata.find( delimiter ) ) != std::string::npos )
+    // Operations are separated by ";" and any spaces or line breaks, the
+    // metadata is scanned in place rather than erased from the front
+    while( start < end )
     {
-        // Extract the operation
-        token = metadata.substr( 0, pos );
-        // Push it into the vector
-        tokens.push_back( token );
-        //Remove the operation
-        metadata.erase( 0, pos + delimiter.length() );
+        size_t pos = std::min( metadata.find( ';', start ), end );
+        size_t first = metadata.find_first_not_of( space, start );
+        if( first < pos )
+        {
+            size_t last = metadata.find_last_not_of( space, pos - 1 );
+            tokens.push_back( metadata.substr( first, last + 1 - first ) );
+        }
+        start = pos + 1;
     }
-    // Grab the last operation that ends with "." instead of a ";"
-    pos = metadata.find( "." );
-    token = metadata.substr( 0, pos );
-    tokens.push_back( token );
 
     return tokens;
 }
 
 /**
- * @brief       Splits a single operation into a map.
+ * @brief       Parses a single operation without copying any of it.
  * details      The operation must take the form: 
  * "COMPONENT_LETTER(OPERATION)CYCLE_TIME". An example is "I(hard drive)10".
  *
- * @param[in]  data   An operation in the proper format.
+ * @param[in]  operation  An operation.
+ * @param[out] record     The parsed operation, or the reason the operation is
+ * malformed in its Error.
  *
- * @return     A map containing the keys "Component", "Operation", "Cycle".
+ * @return     True if the operation is in the proper format, false otherwise.
  */
-std::map<std::string, std::string> Parser::splitOperation( 
-    std::string operation )
+bool Parser::parseOperation( const std::string& operation, 
+    OperationRecord& record )
 {
-    std::map<std::string, std::string> operationMap;
-    std::string token;
-    std::string delimiter = ")";
-    
-    size_t pos = 0;
+    record = OperationRecord{ '\0', 0, 0, 0, nullptr };
 
     // <Component Letter>(<Operation>)<Cycle Time>
     // Get component letter
-    pos = 1;
-    token = operation.substr( 0, pos );
-    operationMap["Component"] = token;
-    operation.erase( 0, pos + 1 );
+    if( operation.size() < 2 || operation[ 1 ] != '(' )
+    {
+        record.Error = "expected a component letter followed by \"(\"";
+        return false;
+    }
+    record.Component = operation[ 0 ];
+    if( std::string( "SAPIO" ).find( record.Component ) == std::string::npos )
+    {
+        record.Error = "unknown component letter";
+        return false;
+    }
 
     // <Operation>)<Cycle Time>
     // Get operation
-    pos = operation.find( delimiter );
-    token = operation.substr( 0, pos );
-    operationMap["Operation"] = token;
-    operation.erase( 0, pos + delimiter.length() );
+    size_t close = operation.find( ')', 2 );
+    if( close == std::string::npos )
+    {
+        record.Error = "missing \")\"";
+        return false;
+    }
+    record.NameStart = 2;
+    record.NameLength = close - 2;
 
     // <Cycle Time>
     // Get cycle time
-    operationMap["Cycle"] = operation;
+    if( close + 1 == operation.size() )
+    {
+        record.Error = "missing cycle count";
+        return false;
+    }
+    long long cycles = 0;
+    for( size_t pos = close + 1; pos < operation.size(); pos++ )
+    {
+        if( operation[ pos ] < '0' || operation[ pos ] > '9' )
+        {
+            record.Error = "cycle count is not a number";
+            return false;
+        }
+        cycles = cycles * 10 + ( operation[ pos ] - '0' );
+        if( cycles > std::numeric_limits<int>::max() )
+        {
+            record.Error = "cycle count is too large";
+            return false;
+        }
+    }
+    record.Cycles = static_cast<int>( cycles );
+
+    return true;
+}
+
+/**
+ * @brief      Whether a parsed operation has a given name.
+ *
+ * @param[in]  operation  The operation that was parsed.
+ * @param[in]  record     The operation's record.
+ * @param[in]  name       The name to compare with, such as "start".
+ *
+ * @return     True if the names are equal, false otherwise.
+ */
+bool Parser::isNamed( const std::string& operation, 
+    const OperationRecord& record, const char* name )
+{
+    return operation.compare( record.NameStart, record.NameLength, name ) == 0;
+}
 
-    return operationMap;
-}
\ No newline at end of file
+/**
+ * @brief      Copies the name out of a parsed operation.
+ *
+ * @param[in]  operation  The operation that was parsed.
+ * @param[in]  record     The operation's record.
+ *
+ * @return     The name, such as "hard drive".
+ */
+std::string Parser::nameOf( const std::string& operation, 
+    const OperationRecord& record )
+{
+    return operation.substr( record.NameStart, record.NameLength );
+}
@@ -9,12 +9,32 @@
 
 #include "config.h"
 
+/**
+ * @brief      One meta-data operation, such as "I(hard drive)10", as parsed by
+ * Parser::parseOperation().
+ * @details    The name is not copied out of the operation, it is the
+ * NameLength characters at NameStart of the text that was parsed.
+ */
+struct OperationRecord
+{
+    char Component;
+    size_t NameStart;
+    size_t NameLength;
+    int Cycles;
+    const char* Error;
+};
+
 namespace Parser
 {
     std::string loadData( std::string path );
     void parseConfig( std::string data, Config& config );
     std::list<std::string> splitMetaData( std::string metadata );
-    std::map<std::string, std::string> splitOperation( std::string operation );
+    bool parseOperation( const std::string& operation, 
+        OperationRecord& record );
+    bool isNamed( const std::string& operation, const OperationRecord& record,
+        const char* name );
+    std::string nameOf( const std::string& operation, 
+        const OperationRecord& record );
 }
 
 #endif  //  PARSER_H
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file     completions.cpp
+ * @brief    Checks that requests completing sooner than a window are not held
+ * back to its end: a buffer cache hit completes exactly its hit time after it
+ * starts, and spooled output lets its application continue with zero wait.
+ *
+ * @details  Usage: ./completions
+ * Two applications on two processors read the only block of a one block disk
+ * twice and write to a spooled printer. Their first reads are in flight
+ * together, so both miss, and their second reads hit the cache.
+ * Every cycle time is far longer than the hit time, so windows are too.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "Tools/config.h"
+#include "Tools/log.h"
+#include "Tools/parser.h"
+#include "Simulation/simulator.h"
+
+/**
+ * @brief      Finds how long every I/O operation of a kind took in a log.
+ *
+ * @param[in]  log        The simulation's log.
+ * @param[in]  operation  The operation, such as "hard drive input".
+ *
+ * @return     The time in ms of each operation, in the order they ended.
+ */
+std::list<long long> durations( const std::string& log,
+    const std::string& operation )
+{
+    std::map<std::string, double> started;
+    std::list<long long> times;
+    std::istringstream stream( log );
+    std::string line;
+
+    while( std::getline( stream, line ) )
+    {
+        size_t process = line.find( " - Process " );
+        size_t colon = line.find( ": " );
+        if( process == std::string::npos || colon == std::string::npos ||
+            line.size() < operation.size() || line.compare( line.size() -
+            operation.size(), operation.size(), operation ) != 0 )
+        {
+            continue;
+        }
+
+        std::string app = line.substr( process, colon - process );
+        double time = std::atof( line.c_str() );
+        if( line.compare( colon + 2, 5, "START" ) == 0 )
+            started[ app ] = time;
+        else
+            times.push_back( std::llround( ( time - started[ app ] ) * 1000 ) );
+    }
+    return times;
+}
+
+int main()
+{
+    Config config;
+    config.schedulingCode = "RR";
+    config.quantumTime = 3;
+    config.processorCycle = 10;
+    config.monitorDisplayCycle = 20;
+    config.hardDriveCycle = 15;
+    config.printerCycle = 25;
+    config.keyboardCycle = 50;
+    config.processors = 2;
+    config.timeMode = "Simulated";
+    config.bufferCacheBlocks = 1;
+    config.bufferCacheHitTime = 1;
+    config.diskBlocks = 1;
+    config.printerSpool = 2;
+    config.log = "Log to File";
+    config.logFilePath = "completions.lgf";
+
+    std::list<std::string> workload = { "S(start)0" };
+    for( int app = 0; app < 2; app++ )
+    {
+        workload.insert( workload.end(), { "A(start)0", "P(run)2",
+            "I(hard drive)2", "P(run)1", "I(hard drive)2", "O(printer)3",
+            "P(run)1", "A(end)0" } );
+    }
+    workload.push_back( "S(end)0" );
+
+    // Only the simulation itself is logged, not its preparation
+    Config quiet = config;
+    quiet.log = "Log to None";
+    logger.setConfig( quiet );
+    Simulator sim( config, workload );
+
+    logger.setConfig( config );
+    sim.start();
+    logger.closeFile();
+    std::string log = Parser::loadData( config.logFilePath );
+    std::remove( config.logFilePath.c_str() );
+
+    // The disk only has one block, every read after the first two hits
+    int hits = 0;
+    std::list<long long> reads = durations( log, "hard drive input" );
+    for( std::list<long long>::iterator read = reads.begin();
+         read != reads.end(); ++read )
+    {
+        if( *read == config.bufferCacheHitTime )
+            hits++;
+    }
+
+    bool spooled = true;
+    std::list<long long> writes = durations( log, "printer output" );
+    for( std::list<long long>::iterator write = writes.begin();
+         write != writes.end(); ++write )
+    {
+        spooled = spooled && *write == 0;
+    }
+
+    bool passed = hits == static_cast<int>( reads.size() ) - 2 &&
+        writes.size() == 2 && spooled;
+    std::cout << "cache hits " << hits << " of " << reads.size()
+        << " reads at " << config.bufferCacheHitTime << " ms, spooled writes "
+        << ( spooled ? "without" : "WITH" ) << " waiting: "
+        << ( passed ? "passed" : "FAILED" ) << std::endl;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file     configkeys.cpp
+ * @brief    Checks that the config parser accepts a complete config and
+ * rejects one that would simulate wrongly: a processor cycle time of 0, an
+ * unknown scheduling code, or a key given twice.
+ *
+ * @details  Usage: ./configkeys
+ * Each case changes or adds one line of config_1.cnf's settings and reports
+ * whether Parser::parseConfig accepted it as expected.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Tools/config.h"
+#include "Tools/parser.h"
+
+/**
+ * @brief      The settings of config_1.cnf.
+ */
+const std::string Settings =
+    "Start Simulator Configuration File\n"
+    "Version/Phase: 2.0\n"
+    "File Path: Test_3.mdf\n"
+    "CPU Scheduling Code: RR\n"
+    "Quantum Time (cycles): 3\n"
+    "Processor cycle time (msec): 10\n"
+    "Monitor display time (msec): 20\n"
+    "Hard drive cycle time (msec): 15\n"
+    "Printer cycle time (msec): 25\n"
+    "Keyboard cycle time (msec): 50\n"
+    "Log: Log to Both\n"
+    "Log File Path: logfile_1.lgf\n"
+    "End Simulator Configuration File\n";
+
+/**
+ * @brief      Parses the settings with one line replaced, or one line added,
+ * and reports the result.
+ *
+ * @param[in]  line      The line to replace, such as "Log: Log to Both", or
+ * "" to add a line.
+ * @param[in]  with      The line to put in its place.
+ * @param[in]  expected  Whether the config should be accepted.
+ *
+ * @return     True if the parser accepted the config as expected.
+ */
+bool check( const std::string& line, const std::string& with, bool expected )
+{
+    std::string data = Settings;
+    if( line.empty() )
+        data.insert( data.rfind( "End " ), with + "\n" );
+    else
+        data.replace( data.find( line + "\n" ), line.size(), with );
+
+    Config config;
+    bool accepted = Parser::parseConfig( data, config );
+    std::cout << "  \"" << with << "\": " 
+        << ( accepted ? "accepted" : "rejected" ) 
+        << ( accepted == expected ? "" : ", FAILED" ) << std::endl;
+    return accepted == expected;
+}
+
+int main()
+{
+    bool passed = true;
+    passed = check( "Log: Log to Both", "Log: Log to Both", true ) && passed;
+    passed = check( "Processor cycle time (msec): 10", 
+        "Processor cycle time (msec): 0", false ) && passed;
+    passed = check( "Processor cycle time (msec): 10", 
+        "Processor cycle time (msec): 1", true ) && passed;
+    passed = check( "CPU Scheduling Code: RR", "CPU Scheduling Code: SJF", 
+        false ) && passed;
+    passed = check( "", "Log: Log to File", false ) && passed;
+
+    std::cout << ( passed ? "passed" : "FAILED" ) << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file     copies.cpp
+ * @brief    Checks that the workload is built in place: no application or
+ * operation is moved, let alone copied, while a workload is built from its
+ * meta-data or straight from the generator, or while it is simulated.
+ *
+ * @details  Usage: ./copies [programs] [operations]
+ * Built with COUNT_COPIES defined (see copies.h) by "make copies". A workload
+ * of mixed programs (10^4 programs of 20 operations by default) is prepared
+ * both ways and each is simulated on 4 processors.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "Tools/config.h"
+#include "Tools/copies.h"
+#include "Tools/generator.h"
+#include "Tools/log.h"
+#include "Tools/parser.h"
+#include "Simulation/simulator.h"
+
+/**
+ * @brief      Reports the moves made by one step of the check.
+ *
+ * @param[in]  step    What was done, such as "parsed build".
+ * @param[in]  before  Copies::count() before the step.
+ *
+ * @return     True if nothing was moved, false otherwise.
+ */
+bool report( const std::string& step, unsigned long long before )
+{
+    unsigned long long moves = Copies::count() - before;
+    std::cout << "  " << step << ": " << moves << " moves" << std::endl;
+    return moves == 0;
+}
+
+int main( int argc, char** argv )
+{
+    if( !( Copies::enabled() ) )
+    {
+        std::cout << "Copies are not counted in this build, use \"make copies\""
+            << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    GeneratorOptions options;
+    options.programs = argc > 1 ? std::atoll( argv[ 1 ] ) : 10000;
+    options.operations = argc > 2 ? std::atoi( argv[ 2 ] ) : 20;
+    options.seed = 466;
+    options.profile = "Mixed";
+    options.meanArrival = 5;
+
+    Config config;
+    config.schedulingCode = "RR";
+    config.quantumTime = 3;
+    config.processorCycle = 10;
+    config.monitorDisplayCycle = 20;
+    config.hardDriveCycle = 15;
+    config.printerCycle = 25;
+    config.keyboardCycle = 50;
+    config.processors = 4;
+    config.timeMode = "Simulated";
+    config.log = "Log to None";
+    logger.setConfig( config );
+
+    std::cout << options.programs << " programs of " << options.operations
+        << " operations" << std::endl;
+
+    std::ostringstream stream;
+    Generator generator( options );
+    generator.write( stream );
+    std::list<std::string> metaData = Parser::splitMetaData( stream.str() );
+
+    bool passed = true;
+    unsigned long long before = Copies::count();
+    Simulator parsed( config, metaData );
+    passed = report( "built from meta-data", before ) && passed;
+
+    before = Copies::count();
+    parsed.start();
+    passed = report( "simulated", before ) && passed;
+
+    before = Copies::count();
+    Simulator generated( config, options );
+    passed = report( "built from the generator", before ) && passed;
+
+    before = Copies::count();
+    generated.start();
+    passed = report( "simulated", before ) && passed;
+
+    std::cout << ( passed ? "passed" : "FAILED" ) << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
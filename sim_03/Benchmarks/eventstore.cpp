@@ -0,0 +1,148 @@
+/**
+ * @file     eventstore.cpp
+ * @brief    Measures how fast the binary heap and the timing wheel insert
+ * and pop pending events, and checks that both pop them in the same order.
+ *
+ * @details  Usage: ./eventstore [pending ...]
+ * For every pending count (10^6 and 10^7 by default) the store is filled with
+ * events spread over the next 10 s, then runs the hold model: as many times
+ * as there are pending events, the earliest event is popped and a new one is
+ * pushed a random delay later. Finally every event is popped.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "Tools/random.h"
+#include "Tools/timer.h"
+#include "Tools/timingwheel.h"
+
+/**
+ * @brief      A pending event, ordered like the simulation's events.
+ */
+struct Event
+{
+    long long Time;
+    long long Sequence;
+
+    bool operator<( const Event& other ) const
+    {
+        if( Time != other.Time )
+            return Time > other.Time;
+        return Sequence > other.Sequence;
+    }
+};
+
+/**
+ * @brief      The rates of one run, in millions of operations per second.
+ */
+struct Rates
+{
+    double Insert;
+    double Hold;
+    double Pop;
+    unsigned long long Checksum;
+};
+
+/**
+ * @brief      The seconds since a time point.
+ *
+ * @param[in]  start  The time point.
+ *
+ * @return     The elapsed seconds.
+ */
+double since( std::chrono::time_point<CLOCK> start )
+{
+    std::chrono::duration<double> elapsed = CLOCK::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief      Fills, holds, and drains an event store.
+ *
+ * @tparam     Store    std::priority_queue<Event> or TimingWheel<Event>.
+ *
+ * @param[in]  pending  The number of pending events.
+ *
+ * @return     The rates and a checksum of the order events were popped in.
+ */
+template <typename Store>
+Rates measure( int pending )
+{
+    const int horizon = 10000;
+    Random random( 466 );
+    Store store;
+    long long sequence = 0;
+    long long now = 0;
+    Rates rates = { 0.0, 0.0, 0.0, 0 };
+
+    std::chrono::time_point<CLOCK> start = CLOCK::now();
+    for( int event = 0; event < pending; event++ )
+    {
+        store.push( Event{ 1 + static_cast<long long>(
+            random.below( horizon ) ), sequence++ } );
+    }
+    rates.Insert = pending / since( start ) / 1e6;
+
+    start = CLOCK::now();
+    for( int event = 0; event < pending; event++ )
+    {
+        now = store.top().Time;
+        rates.Checksum = rates.Checksum * 31 + store.top().Sequence;
+        store.pop();
+        store.push( Event{ now + 1 + static_cast<long long>(
+            random.below( horizon ) ), sequence++ } );
+    }
+    rates.Hold = pending / since( start ) / 1e6;
+
+    start = CLOCK::now();
+    while( !( store.empty() ) )
+    {
+        rates.Checksum = rates.Checksum * 31 + store.top().Sequence;
+        store.pop();
+    }
+    rates.Pop = pending / since( start ) / 1e6;
+
+    return rates;
+}
+
+/**
+ * @brief      Prints the rates of one store.
+ *
+ * @param[in]  name   The name of the store.
+ * @param[in]  rates  Its rates.
+ */
+void print( const std::string& name, const Rates& rates )
+{
+    std::cout << "  " << name << ": insert " << rates.Insert
+        << " M/s, hold " << rates.Hold << " M/s, pop " << rates.Pop
+        << " M/s" << std::endl;
+}
+
+int main( int argc, char** argv )
+{
+    std::vector<int> counts;
+    for( int arg = 1; arg < argc; arg++ )
+        counts.push_back( std::atoi( argv[ arg ] ) );
+    if( counts.empty() )
+        counts = { 1000000, 10000000 };
+
+    for( size_t count = 0; count < counts.size(); count++ )
+    {
+        std::cout << counts[ count ] << " pending events" << std::endl;
+        Rates heap = measure< std::priority_queue<Event> >( counts[ count ] );
+        print( "binary heap ", heap );
+        Rates wheel = measure< TimingWheel<Event> >( counts[ count ] );
+        print( "timing wheel", wheel );
+
+        std::cout << "  pop order "
+            << ( heap.Checksum == wheel.Checksum ? "identical" : "DIFFERS" )
+            << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file     generation.cpp
+ * @brief    Measures how workload generation scales with the number of
+ * threads, and checks that every thread count generates exactly the same file.
+ *
+ * @details  Usage: ./generation [programs] [operations]
+ * A workload (2 * 10^5 programs of 20 operations by default) is generated in
+ * memory with 1, 4 and 16 threads from a fixed seed. Each is compared to the
+ * one thread workload, the program fails if any differs.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "Tools/generator.h"
+#include "Tools/timer.h"
+
+int main( int argc, char** argv )
+{
+    GeneratorOptions options;
+    options.programs = argc > 1 ? std::atoll( argv[ 1 ] ) : 200000;
+    options.operations = argc > 2 ? std::atoi( argv[ 2 ] ) : 20;
+    options.processingPercent = 50;
+    options.seed = 466;
+
+    std::cout << options.programs << " programs of " << options.operations
+        << " operations" << std::endl;
+
+    static const int threadCounts[] = { 1, 4, 16 };
+    std::string baseline;
+    double baselineSeconds = 0.0;
+    bool identical = true;
+    for( int index = 0; index < 3; index++ )
+    {
+        options.threads = threadCounts[ index ];
+        std::ostringstream stream;
+
+        std::chrono::time_point<CLOCK> start = CLOCK::now();
+        Generator generator( options );
+        generator.write( stream );
+        std::chrono::duration<double> elapsed = CLOCK::now() - start;
+
+        std::string workload = stream.str();
+        if( index == 0 )
+        {
+            baseline = workload;
+            baselineSeconds = elapsed.count();
+        }
+        identical = identical && workload == baseline;
+
+        std::cout << "  " << options.threads << " threads: "
+            << elapsed.count() << " s, "
+            << workload.size() / 1e6 / elapsed.count() << " MB/s, speedup "
+            << baselineSeconds / elapsed.count() << "x, workload "
+            << ( workload == baseline ? "identical" : "DIFFERS" ) << std::endl;
+    }
+
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
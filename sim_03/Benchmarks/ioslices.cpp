@@ -0,0 +1,113 @@
+/**
+ * @file     ioslices.cpp
+ * @brief    Checks that input and output are charged against the quantum the
+ * same way whether they block the processor or complete as interrupts.
+ *
+ * @details  Usage: ./ioslices
+ * One application runs "P(run)1; I(hard drive)7; P(run)1" in real time with a
+ * quantum of 3 cycles, once with "I/O completion: Blocking" and once with
+ * "Interrupt". The first quantum has 2 cycles left for the input, the next
+ * quantum 3 and the last the remaining 2, so both modes must read in slices
+ * of 2, 3 and 2 hard drive cycles.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+
+#include "Tools/config.h"
+#include "Tools/log.h"
+#include "Tools/parser.h"
+#include "Simulation/simulator.h"
+
+/**
+ * @brief      Runs the workload with one way of completing I/O.
+ *
+ * @param[in]  config  The configuration, which logs to a file.
+ *
+ * @return     The hard drive cycles of every slice of input, in order.
+ */
+std::list<long long> slices( Config config )
+{
+    std::list<std::string> workload = { "S(start)0", "A(start)0", "P(run)1",
+        "I(hard drive)7", "P(run)1", "A(end)0", "S(end)0" };
+
+    Config quiet = config;
+    quiet.log = "Log to None";
+    logger.setConfig( quiet );
+    Simulator sim( config, workload );
+
+    logger.setConfig( config );
+    sim.start();
+    logger.closeFile();
+    std::string log = Parser::loadData( config.logFilePath );
+    std::remove( config.logFilePath.c_str() );
+
+    // Each slice is logged as a START and an END of the input
+    std::list<long long> cycles;
+    std::istringstream stream( log );
+    std::string line;
+    double started = 0;
+    while( std::getline( stream, line ) )
+    {
+        if( line.find( "hard drive input" ) == std::string::npos )
+            continue;
+
+        double time = std::atof( line.c_str() );
+        if( line.find( ": START " ) != std::string::npos )
+            started = time;
+        else
+            cycles.push_back( std::llround( ( time - started ) * 1000 /
+                config.hardDriveCycle ) );
+    }
+    return cycles;
+}
+
+/**
+ * @brief      Prints the slices of one mode.
+ *
+ * @param[in]  mode    The I/O completion mode.
+ * @param[in]  cycles  Its slices.
+ */
+void report( const std::string& mode, const std::list<long long>& cycles )
+{
+    std::cout << "  " << mode << ":";
+    for( std::list<long long>::const_iterator slice = cycles.begin();
+         slice != cycles.end(); ++slice )
+    {
+        std::cout << " " << *slice;
+    }
+    std::cout << std::endl;
+}
+
+int main()
+{
+    Config config;
+    config.schedulingCode = "RR";
+    config.quantumTime = 3;
+    config.processorCycle = 10;
+    config.monitorDisplayCycle = 20;
+    config.hardDriveCycle = 40;
+    config.printerCycle = 25;
+    config.keyboardCycle = 50;
+    config.timeMode = "Real";
+    config.log = "Log to File";
+    config.logFilePath = "ioslices.lgf";
+
+    config.ioCompletion = "Blocking";
+    std::list<long long> blocking = slices( config );
+    config.ioCompletion = "Interrupt";
+    std::list<long long> interrupt = slices( config );
+
+    std::list<long long> expected = { 2, 3, 2 };
+    bool passed = blocking == expected && interrupt == expected;
+    report( "blocking", blocking );
+    report( "interrupt", interrupt );
+    std::cout << ( passed ? "passed" : "FAILED" ) << std::endl;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file     pipeline.cpp
+ * @brief    Measures how much preparing a generated workload costs when it is
+ * written as meta-data and parsed back, compared to building it straight from
+ * the generator, and checks that both simulate exactly the same.
+ *
+ * @details  Usage: ./pipeline [programs] [operations]
+ * A workload (2 * 10^4 programs of 20 operations by default) of mixed
+ * programs arriving every 5 ms on average is prepared both ways, then each is
+ * simulated on 4 processors with logging to a file for comparison.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+
+#include "Tools/config.h"
+#include "Tools/generator.h"
+#include "Tools/log.h"
+#include "Tools/parser.h"
+#include "Simulation/simulator.h"
+
+/**
+ * @brief      Simulates a prepared workload, logging only the simulation.
+ *
+ * @param[in]  config  The configuration, which logs to a file.
+ * @param      sim     The prepared simulator.
+ *
+ * @return     The simulation's log.
+ */
+std::string simulate( Config config, Simulator& sim )
+{
+    logger.setConfig( config );
+    sim.start();
+    logger.closeFile();
+
+    return Parser::loadData( config.logFilePath );
+}
+
+int main( int argc, char** argv )
+{
+    GeneratorOptions options;
+    options.programs = argc > 1 ? std::atoll( argv[ 1 ] ) : 20000;
+    options.operations = argc > 2 ? std::atoi( argv[ 2 ] ) : 20;
+    options.seed = 466;
+    options.profile = "Mixed";
+    options.meanArrival = 5;
+
+    Config config;
+    config.schedulingCode = "RR";
+    config.quantumTime = 3;
+    config.processorCycle = 10;
+    config.monitorDisplayCycle = 20;
+    config.hardDriveCycle = 15;
+    config.printerCycle = 25;
+    config.keyboardCycle = 50;
+    config.processors = 4;
+    config.timeMode = "Simulated";
+    config.logFilePath = "pipeline.lgf";
+
+    std::cout << options.programs << " programs of " << options.operations
+        << " operations" << std::endl;
+
+    // Only the simulation itself is logged, not its wall clock preparation
+    Config quiet = config;
+    quiet.log = "Log to None";
+    logger.setConfig( quiet );
+    config.log = "Log to File";
+
+    std::chrono::time_point<CLOCK> start = CLOCK::now();
+    std::ostringstream stream;
+    Generator generator( options );
+    generator.write( stream );
+    Simulator parsed( config, Parser::splitMetaData( stream.str() ) );
+    std::chrono::duration<double> parsedTime = CLOCK::now() - start;
+    std::string parsedLog = simulate( config, parsed );
+
+    logger.setConfig( quiet );
+    start = CLOCK::now();
+    Simulator generated( config, options );
+    std::chrono::duration<double> generatedTime = CLOCK::now() - start;
+    std::string generatedLog = simulate( config, generated );
+
+    bool identical = generatedLog == parsedLog;
+    std::cout << "  written and parsed: " << parsedTime.count() << " s"
+        << std::endl;
+    std::cout << "  generated in memory: " << generatedTime.count()
+        << " s, speedup " << parsedTime.count() / generatedTime.count()
+        << "x, log " << ( identical ? "identical" : "DIFFERS" ) << std::endl;
+
+    std::remove( config.logFilePath.c_str() );
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file     remainingtime.cpp
+ * @brief    Measures how fast the remaining time of every application is
+ * computed from the operation table, as the shortest remaining time policies
+ * need when ranking applications at startup.
+ *
+ * @details  Usage: ./remainingtime [applications] [operations]
+ * A table is filled from a fixed seed (10^6 applications of 10 operations by
+ * default), then every application's remaining time is summed row by row and
+ * by the table's range kernel, which uses AVX2 when built with
+ * "make remainingtime SIMD=avx2". Both sums are checked to agree, and the
+ * applications are ranked by them.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "Tools/arena.h"
+#include "Tools/config.h"
+#include "Tools/random.h"
+#include "Tools/timer.h"
+#include "Simulation/operation.h"
+#include "Simulation/operationtable.h"
+
+/**
+ * @brief      The seconds since a time point.
+ *
+ * @param[in]  start  The time point.
+ *
+ * @return     The elapsed seconds.
+ */
+double since( std::chrono::time_point<CLOCK> start )
+{
+    std::chrono::duration<double> elapsed = CLOCK::now() - start;
+    return elapsed.count();
+}
+
+int main( int argc, char** argv )
+{
+    int applications = argc > 1 ? std::atoi( argv[ 1 ] ) : 1000000;
+    int operations = argc > 2 ? std::atoi( argv[ 2 ] ) : 10;
+
+    static const char components[] = { 'P', 'I', 'I', 'O', 'O', 'O' };
+    static const char* names[] = { "run", "hard drive", "keyboard",
+        "hard drive", "monitor", "printer" };
+
+    Config config;
+    config.processorCycle = 10;
+    config.hardDriveCycle = 50;
+    config.keyboardCycle = 25;
+    config.monitorDisplayCycle = 20;
+    config.printerCycle = 100;
+
+    Random random( 466 );
+    Arena arena;
+    OperationTable table( config, arena );
+    table.reserve( static_cast<size_t>( applications ) * operations );
+    std::vector<size_t> bounds( 1, 0 );
+    for( int app = 0; app < applications; app++ )
+    {
+        for( int operation = 0; operation < operations; operation++ )
+        {
+            int kind = static_cast<int>( random.below( 6 ) );
+            table.add( Operation( components[ kind ], names[ kind ],
+                std::strlen( names[ kind ] ),
+                1 + static_cast<int>( random.below( 20 ) ) ) );
+        }
+        bounds.push_back( table.size() );
+    }
+
+    std::vector<long long> rowTimes( applications );
+    std::chrono::time_point<CLOCK> start = CLOCK::now();
+    for( int app = 0; app < applications; app++ )
+    {
+        long long remainingTime = 0;
+        for( size_t index = bounds[ app ]; index < bounds[ app + 1 ]; index++ )
+            remainingTime += table.getRemainingTime( index );
+        rowTimes[ app ] = remainingTime;
+    }
+    double rowSeconds = since( start );
+
+    std::vector<long long> rangeTimes( applications );
+    start = CLOCK::now();
+    for( int app = 0; app < applications; app++ )
+    {
+        rangeTimes[ app ] = table.getRemainingTime( bounds[ app ],
+            bounds[ app + 1 ] );
+    }
+    double rangeSeconds = since( start );
+
+    std::vector<int> ranking( applications );
+    for( int app = 0; app < applications; app++ )
+        ranking[ app ] = app;
+    start = CLOCK::now();
+    std::stable_sort( ranking.begin(), ranking.end(),
+        [&rangeTimes]( int app1, int app2 )
+        {
+            return rangeTimes[ app1 ] < rangeTimes[ app2 ];
+        } );
+    double rankSeconds = since( start );
+
+    std::cout << applications << " applications of " << operations
+        << " operations" << std::endl;
+#ifdef __AVX2__
+    std::cout << "  range kernel: AVX2" << std::endl;
+#else
+    std::cout << "  range kernel: scalar" << std::endl;
+#endif
+    std::cout << "  row by row  : " << rowSeconds * 1000 << " ms" << std::endl;
+    std::cout << "  range kernel: " << rangeSeconds * 1000 << " ms"
+        << std::endl;
+    std::cout << "  ranking     : " << rankSeconds * 1000 << " ms" << std::endl;
+    std::cout << "  remaining times "
+        << ( rowTimes == rangeTimes ? "identical" : "DIFFER" ) << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file     speedup.cpp
+ * @brief    Measures how the multiple processor simulation scales with the
+ * number of host threads, and checks that every thread count logs exactly the
+ * same simulation as the sequential reference.
+ *
+ * @details  Usage: ./speedup [processors] [applications] [operations]
+ * A workload is generated from a fixed seed and simulated once with
+ * "Synchronization: Sequential", one instant at a time on one thread, logging
+ * to a file. It is then simulated in windows once per host thread count (1, 2,
+ * 4, ... up to the number of processors) with logging off for timing, and
+ * once more with logging to a file for comparison with the reference.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+
+#include "Tools/config.h"
+#include "Tools/log.h"
+#include "Tools/parser.h"
+#include "Tools/random.h"
+#include "Simulation/simulator.h"
+
+/**
+ * @brief      Generates a workload in the meta-data operation format.
+ *
+ * @param[in]  applications  The number of applications.
+ * @param[in]  operations    The number of operations per application.
+ *
+ * @return     Every operation, starting with "S(start)0".
+ */
+std::list<std::string> generate( int applications, int operations )
+{
+    static const char* devices[] = { "I(hard drive)", "I(keyboard)",
+        "O(hard drive)", "O(monitor)", "O(printer)" };
+    Random random( 466 );
+    std::list<std::string> workload;
+
+    workload.push_back( "S(start)0" );
+    for( int app = 0; app < applications; app++ )
+    {
+        workload.push_back( "A(start)0" );
+        for( int op = 0; op < operations; op++ )
+        {
+            int cycles = 5 + static_cast<int>( random.below( 11 ) );
+            if( random.below( 100 ) < 60 )
+                workload.push_back( "P(run)" + std::to_string( cycles ) );
+            else
+                workload.push_back( devices[ random.below( 5 ) ] + 
+                    std::to_string( cycles ) );
+        }
+        workload.push_back( "A(end)0" );
+    }
+    workload.push_back( "S(end)0" );
+
+    return workload;
+}
+
+/**
+ * @brief      Simulates the workload once.
+ *
+ * @param[in]  config    The configuration, including the host thread count.
+ * @param[in]  workload  The operations to simulate.
+ *
+ * @return     The time in seconds the simulation took, excluding preparation.
+ */
+double simulate( Config config, const std::list<std::string>& workload )
+{
+    // Only the simulation itself is logged, not its wall clock preparation
+    Config quiet = config;
+    quiet.log = "Log to None";
+    logger.setConfig( quiet );
+    Simulator sim( config, workload );
+
+    logger.setConfig( config );
+    std::chrono::time_point<CLOCK> start = CLOCK::now();
+    sim.start();
+    std::chrono::duration<double> elapsed = CLOCK::now() - start;
+    logger.closeFile();
+
+    return elapsed.count();
+}
+
+/**
+ * @brief      Simulates the workload once and logs it to a file.
+ *
+ * @param[in]  config    The configuration, including the host thread count.
+ * @param[in]  workload  The operations to simulate.
+ *
+ * @return     The simulation's log.
+ */
+std::string logged( Config config, const std::list<std::string>& workload )
+{
+    config.log = "Log to File";
+    config.logFilePath = "speedup.lgf";
+    simulate( config, workload );
+
+    std::string log = Parser::loadData( config.logFilePath );
+    std::remove( config.logFilePath.c_str() );
+    return log;
+}
+
+int main( int argc, char** argv )
+{
+    int processors = argc > 1 ? std::atoi( argv[1] ) : 16;
+    int applications = argc > 2 ? std::atoi( argv[2] ) : 20000;
+    int operations = argc > 3 ? std::atoi( argv[3] ) : 20;
+
+    Config config;
+    config.schedulingCode = "RR";
+    config.quantumTime = 3;
+    config.processorCycle = 10;
+    config.monitorDisplayCycle = 20;
+    config.hardDriveCycle = 15;
+    config.printerCycle = 25;
+    config.keyboardCycle = 50;
+    config.processors = processors;
+    config.timeMode = "Simulated";
+    config.log = "Log to None";
+
+    std::list<std::string> workload = generate( applications, operations );
+    std::cout << processors << " processors, " << applications 
+        << " applications, " << operations << " operations each" << std::endl;
+
+    Config reference = config;
+    reference.synchronization = "Sequential";
+    std::cout << "  sequential: " << simulate( reference, workload ) << " s"
+        << std::endl;
+    std::string referenceLog = logged( reference, workload );
+
+    double baseline = 0.0;
+    bool identical = true;
+    for( int threads = 1; threads <= processors; threads *= 2 )
+    {
+        config.hostThreads = threads;
+        double seconds = simulate( config, workload );
+        if( threads == 1 )
+            baseline = seconds;
+
+        // Log the same simulation to a file and compare it to the reference
+        bool same = logged( config, workload ) == referenceLog;
+        identical = identical && same;
+
+        std::cout << "  " << threads << " host threads: " << seconds 
+            << " s, speedup " << baseline / seconds << "x, log "
+            << ( same ? "identical" : "DIFFERS" ) << std::endl;
+    }
+
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -9,12 +9,15 @@
  *
  * @param[in]  config      The config file associated with this application.
  * @param[in]  appID       The unique ID associated with this application.
- * @param[in]  operations  The list of operations associated with this 
- * application.
+ * @param      operations  The table holding this application's operations,
+ * it must outlive this application.
+ * @param[in]  first       The row of this application's first operation.
+ * @param[in]  last        The row after this application's last operation.
  */
-Application::Application( Config config, int appID, 
-    std::list<Operation> operations )
-    :   m_config( config ), m_appID( appID ), m_operations( operations )
+Application::Application( const Config& config, int appID, 
+    OperationTable& operations, size_t first, size_t last )
+    :   Tickets( config.defaultTickets ), m_appID( appID ), 
+        m_operations( &operations ), m_head( first ), m_end( last )
 {
     calculateApplicationTime();
 }
@@ -26,40 +29,48 @@ Application::Application( Config config, int appID,
 /**
  * @brief      Executes each process "P", input "I", and output "O" linearly.
  * @details    Each I/O operation executes within its own thread.
+ *
+ * @param[in]  quantumTime  The number of cycles this burst may consume.
+ *
+ * @return     Completed if every operation has finished, IOCompleted if the
+ * application was blocked on I/O during this burst, QuantumExpired otherwise.
  */
-void Application::start()
+BurstResult Application::start( int quantumTime )
 {
     logger << Timer::msDT() << " - OS: " << "START" << " process "
         << m_appID << "\n";
 
-    int remainingQuantumTime = m_config.quantumTime;
-    // Executes each operation within this Application
-    std::list<Operation>::iterator iter = m_operations.begin();
-
+    bool blockedOnIO = false;
+    int remainingQuantumTime = quantumTime;
+    BurstCycles = 0;
     // Executes operations until this application runs out of cycles
     while( remainingQuantumTime > 0 )
     {
         // If there are no operations, then there is no more cycles
-        if( m_operations.empty() )
+        if( isFinished() )
         {
             remainingQuantumTime = 0;
         }
         else
         {
+            int cyclesBefore = remainingQuantumTime;
+
             // Create interrupt by enabling / disabling a "Blocked" state
-            if( iter->Component == "I" || iter->Component == "O" )
+            if( m_operations->isIO( m_head ) )
             {
                 Blocked = true;
-                iter->execute( remainingQuantumTime );
+                m_operations->execute( m_head, m_appID, remainingQuantumTime );
                 Blocked = false;
+                blockedOnIO = true;
             // Else simply execute the operation
             } else {
-                iter->execute( remainingQuantumTime );
+                m_operations->execute( m_head, m_appID, remainingQuantumTime );
             } 
+            BurstCycles += cyclesBefore - remainingQuantumTime;
 
-            // Remove the operation if it is completed
-            if( iter->RemainingCycles == 0 )
-                m_operations.erase( iter++ );
+            // Move past the operation if it is completed
+            if( m_operations->getRemainingCycles( m_head ) == 0 )
+                m_head++;
         }
 
         // Recalculate application time, relevant for SRTF-P
@@ -68,6 +79,201 @@ void Application::start()
 
     logger << Timer::msDT() << " - OS: " << "END" << " process "
         << m_appID << "\n";
+
+    if( ApplicationTime == 0 )
+        return BurstResult::Completed;
+    else if( blockedOnIO )
+        return BurstResult::IOCompleted;
+    return BurstResult::QuantumExpired;
+}
+
+/**
+ * @brief      Executes process "P" operations for up to one quantum without
+ * waiting, used when the simulation keeps its own clock.
+ * @details    The burst stops early when the next operation is an input or
+ * output, which the caller must then complete with startIO() and finishIO().
+ *
+ * @param[in]  quantumTime  The number of cycles this burst may consume.
+ * @param[out] elapsedTime  The time in ms the burst took.
+ *
+ * @return     Completed if every operation has finished, IOCompleted if the
+ * application must now block on I/O, QuantumExpired otherwise.
+ */
+BurstResult Application::runProcessor( int quantumTime, int& elapsedTime )
+{
+    int remainingQuantumTime = quantumTime;
+    elapsedTime = 0;
+    BurstCycles = 0;
+
+    while( remainingQuantumTime > 0 && !( isFinished() ) &&
+           !( m_operations->isIO( m_head ) ) )
+    {
+        int cyclesBefore = remainingQuantumTime;
+        elapsedTime += m_operations->consume( m_head, remainingQuantumTime );
+        BurstCycles += cyclesBefore - remainingQuantumTime;
+
+        if( m_operations->getRemainingCycles( m_head ) == 0 )
+            m_head++;
+    }
+
+    // The consumed time is exactly what this application no longer needs
+    ApplicationTime -= elapsedTime;
+
+    if( isFinished() )
+        return BurstResult::Completed;
+    else if( m_operations->isIO( m_head ) )
+        return BurstResult::IOCompleted;
+    return BurstResult::QuantumExpired;
+}
+
+/**
+ * @brief      Begins the input / output operation at the front of this
+ * application without waiting, it remains in progress until finishIO().
+ *
+ * @return     The time in ms the operation takes on its device.
+ */
+long long Application::startIO() const
+{
+    return m_operations->getRemainingTime( m_head );
+}
+
+/**
+ * @brief      Completes the input / output operation at the front of this
+ * application.
+ */
+void Application::finishIO()
+{
+    ApplicationTime -= m_operations->getRemainingTime( m_head );
+    m_head++;
+}
+
+/**
+ * @brief      Begins up to the given cycles of the input / output operation at
+ * the front of this application without waiting, charging them to the
+ * burst as start() charges input and output to the quantum. The operation
+ * remains at the front until finishIOSlice().
+ *
+ * @param[in]  cycles  The cycles left of the application's quantum.
+ * @param[out] cycles  The cycles left once the slice is charged.
+ *
+ * @return     The time in ms the slice takes on its device.
+ */
+long long Application::startIOSlice( int& cycles )
+{
+    int cyclesBefore = cycles;
+    long long time = m_operations->consume( m_head, cycles );
+    BurstCycles += cyclesBefore - cycles;
+    ApplicationTime -= time;
+    return time;
+}
+
+/**
+ * @brief      Completes the slice of the input / output operation at the front
+ * of this application that startIOSlice() began.
+ *
+ * @return     True if the whole operation has completed, false if it has
+ * cycles left for a later quantum.
+ */
+bool Application::finishIOSlice()
+{
+    if( m_operations->getRemainingCycles( m_head ) > 0 )
+        return false;
+
+    m_head++;
+    return true;
+}
+
+/**
+ * @brief      Get the name of the operation this application is currently
+ * executing, such as "hard drive".
+ *
+ * @return     The name of the operation at the front of this application.
+ */
+const std::string& Application::getOperationName() const
+{
+    return m_operations->getName( m_head );
+}
+
+/**
+ * @brief      Whether the operation this application is currently executing
+ * is an input "I" operation.
+ *
+ * @return     True for an input, false otherwise.
+ */
+bool Application::isInput() const
+{
+    return m_operations->isInput( m_head );
+}
+
+/**
+ * @brief      Get the device the operation this application is currently
+ * executing uses.
+ *
+ * @return     The index of the device as in Device::index(), or -1.
+ */
+int Application::getDevice() const
+{
+    return m_operations->getDevice( m_head );
+}
+
+/**
+ * @brief      Get the device address of the operation this application is
+ * currently executing.
+ *
+ * @return     The address.
+ */
+unsigned long long Application::getAddress() const
+{
+    return m_operations->getAddress( m_head );
+}
+
+/**
+ * @brief      Whether every operation within this application has completed.
+ *
+ * @return     True if no operations remain, false otherwise.
+ */
+bool Application::isFinished() const
+{
+    return m_head == m_end;
+}
+
+/**
+ * @brief      Whether the operation this application is currently executing
+ * runs on the processor and has cycles left, so its next burst takes at least
+ * one processor cycle.
+ *
+ * @return     True for a processing operation with cycles left, false
+ * otherwise.
+ */
+bool Application::isProcessing() const
+{
+    return !( isFinished() ) && !( m_operations->isIO( m_head ) ) &&
+        m_operations->getRemainingCycles( m_head ) > 0;
+}
+
+/**
+ * @brief      Get the unique ID of this application, which is also its order
+ * of arrival.
+ *
+ * @return     The ID associated with this application.
+ */
+int Application::getID() const
+{
+    return m_appID;
+}
+
+/**
+ * @brief      The memory this application occupies, its own frame and every
+ * operation it has left.
+ * @details    Operations are counted by their row in the operation table,
+ * whose names are shared by every application.
+ *
+ * @return     The footprint in bytes.
+ */
+size_t Application::footprint() const
+{
+    return sizeof( Application ) + ( m_end - m_head ) * 
+        OperationTable::bytesPerOperation();
 }
 
 //
@@ -80,14 +286,8 @@ void Application::start()
  */
 void Application::calculateApplicationTime()
 {
-    ApplicationTime = 0;
-    // Iterates through the list of operations, adds each operation's
-    // running time to the total running time
-    for( std::list<Operation>::const_iterator iter = m_operations.begin();
-         iter != m_operations.end(); ++iter )
-    {
-        ApplicationTime += iter->getRemainingTime();
-    }
+    // The remaining operations are contiguous rows, summed in one pass
+    ApplicationTime = m_operations->getRemainingTime( m_head, m_end );
 }
 
 //
@@ -5,31 +5,76 @@
 #include <list>
 #include <map>
 #include <chrono>
+#include <vector>
 
+#include "Tools/arena.h"
 #include "Tools/log.h"
 #include "Tools/config.h"
+#include "Tools/copies.h"
 #include "Tools/parser.h"
 #include "Tools/timer.h"
 
-#include "operation.h"
+#include "operationtable.h"
+
+/**
+ * @brief      How an application's burst on the processor ended.
+ */
+enum class BurstResult
+{
+    Completed,
+    QuantumExpired,
+    IOCompleted
+};
 
 class Application
 {
 public:
-    Application( Config config, int appID, std::list<Operation> operations );
+    Application( const Config& config, int appID, OperationTable& operations,
+        size_t first, size_t last );
+    Application( Application&& other ) = default;
+    Application& operator=( Application&& other ) = default;
 
-    void start();
+    // Applications are built in place and only ever moved
+    Application( const Application& ) = delete;
+    Application& operator=( const Application& ) = delete;
 
-    int ApplicationTime;
+    BurstResult start( int quantumTime );
+    BurstResult runProcessor( int quantumTime, int& elapsedTime );
+    long long startIO() const;
+    void finishIO();
+    long long startIOSlice( int& cycles );
+    bool finishIOSlice();
+    const std::string& getOperationName() const;
+    bool isInput() const;
+    int getDevice() const;
+    unsigned long long getAddress() const;
+    bool isFinished() const;
+    bool isProcessing() const;
+    int getID() const;
+    size_t footprint() const;
+
+    long long ApplicationTime;
+    int BurstCycles = 0;
+    int Tickets;
+    long long Arrival = 0;
     bool Blocked = false;
 private:
     void calculateApplicationTime();
 
-    Config m_config;
     int m_appID;
-    std::list<Operation> m_operations;
+    OperationTable* m_operations;
+    size_t m_head;
+    size_t m_end;
+
+#ifdef COUNT_COPIES
+    Copies::Counter m_copies;
+#endif
 
     friend bool operator<( const Application& app1, const Application& app2 );
 };
 
+// Every application of a simulation, allocated from its arena
+typedef std::vector< Application, ArenaAllocator<Application> >
+    ApplicationList;
+
 #endif  //  APPLICATION_H
\ No newline at end of file
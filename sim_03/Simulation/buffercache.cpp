@@ -0,0 +1,183 @@
+#include "buffercache.h"
+
+#include <algorithm>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for an empty cache.
+ *
+ * @param[in]  capacity     The number of blocks the cache holds, 0 disables
+ * the cache.
+ * @param[in]  replacement  "LRU" or "CLOCK", any other value is LRU.
+ */
+BufferCache::BufferCache( int capacity, std::string replacement )
+    :   m_capacity( std::max( capacity, 0 ) ),
+        m_clock( replacement == "CLOCK" ), m_hits( 0 ), m_misses( 0 ),
+        m_hand( 0 )
+{
+    if( m_clock )
+        m_frames.reserve( m_capacity );
+    m_recentIndex.reserve( m_capacity );
+    m_frameIndex.reserve( m_capacity );
+}
+
+//
+// LOOKUPS /////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Looks up a block, a missing block is not cached until it is
+ * filled.
+ *
+ * @param[in]  block  The block number.
+ *
+ * @return     True if the block is cached, false otherwise.
+ */
+bool BufferCache::access( unsigned long long block )
+{
+    bool hit = m_capacity > 0 &&
+        ( m_clock ? touchClock( block ) : touchLRU( block ) );
+    if( hit )
+        m_hits++;
+    else
+        m_misses++;
+    return hit;
+}
+
+/**
+ * @brief      Brings a block that has been read into the cache, which may
+ * evict another. A block that another read has already filled is only used
+ * again.
+ *
+ * @param[in]  block  The block number.
+ */
+void BufferCache::fill( unsigned long long block )
+{
+    if( m_capacity == 0 )
+        return;
+
+    if( m_clock )
+    {
+        if( !( touchClock( block ) ) )
+            insertClock( block );
+    }
+    else if( !( touchLRU( block ) ) )
+    {
+        insertLRU( block );
+    }
+}
+
+/**
+ * @brief      The number of blocks the cache holds.
+ *
+ * @return     The capacity in blocks.
+ */
+int BufferCache::capacity() const
+{
+    return m_capacity;
+}
+
+/**
+ * @brief      The number of lookups that found their block.
+ *
+ * @return     The hits.
+ */
+long long BufferCache::hits() const
+{
+    return m_hits;
+}
+
+/**
+ * @brief      The number of lookups that did not find their block.
+ *
+ * @return     The misses.
+ */
+long long BufferCache::misses() const
+{
+    return m_misses;
+}
+
+//
+// REPLACEMENT /////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Marks a block as the most recently used, if it is cached.
+ *
+ * @param[in]  block  The block number.
+ *
+ * @return     True if the block is cached, false otherwise.
+ */
+bool BufferCache::touchLRU( unsigned long long block )
+{
+    RecencyIndex::iterator found = m_recentIndex.find( block );
+    if( found == m_recentIndex.end() )
+        return false;
+
+    m_recent.splice( m_recent.begin(), m_recent, found->second );
+    return true;
+}
+
+/**
+ * @brief      Caches a block with least recently used replacement.
+ *
+ * @param[in]  block  The block number, not already cached.
+ */
+void BufferCache::insertLRU( unsigned long long block )
+{
+    if( static_cast<int>( m_recent.size() ) == m_capacity )
+    {
+        m_recentIndex.erase( m_recent.back() );
+        m_recent.pop_back();
+    }
+    m_recent.push_front( block );
+    m_recentIndex[ block ] = m_recent.begin();
+}
+
+/**
+ * @brief      Marks a block as referenced, if it is cached.
+ *
+ * @param[in]  block  The block number.
+ *
+ * @return     True if the block is cached, false otherwise.
+ */
+bool BufferCache::touchClock( unsigned long long block )
+{
+    FrameIndex::iterator found = m_frameIndex.find( block );
+    if( found == m_frameIndex.end() )
+        return false;
+
+    m_frames[ found->second ].Referenced = true;
+    return true;
+}
+
+/**
+ * @brief      Caches a block with CLOCK replacement.
+ *
+ * @param[in]  block  The block number, not already cached.
+ */
+void BufferCache::insertClock( unsigned long long block )
+{
+    // Fill the empty frames before replacing any
+    if( static_cast<int>( m_frames.size() ) < m_capacity )
+    {
+        m_frameIndex[ block ] = m_frames.size();
+        m_frames.push_back( Frame{ block, true } );
+        return;
+    }
+
+    // Clear referenced frames until the hand finds one to evict
+    while( m_frames[ m_hand ].Referenced )
+    {
+        m_frames[ m_hand ].Referenced = false;
+        m_hand = ( m_hand + 1 ) % m_capacity;
+    }
+
+    m_frameIndex.erase( m_frames[ m_hand ].Block );
+    m_frames[ m_hand ] = Frame{ block, true };
+    m_frameIndex[ block ] = m_hand;
+    m_hand = ( m_hand + 1 ) % m_capacity;
+}
@@ -0,0 +1,68 @@
+#ifndef BUFFERCACHE_H
+#define BUFFERCACHE_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Tools/pool.h"
+
+/**
+ * @brief      A fixed number of block frames in front of a device, a request
+ * for a block held in a frame is served without the device. A missing block
+ * is only cached once the device has read it.
+ * @details    "LRU" replacement evicts the block used least recently. "CLOCK"
+ * replacement sweeps a hand over the frames, giving every referenced block a
+ * second chance before evicting it.
+ */
+class BufferCache
+{
+public:
+    BufferCache( int capacity, std::string replacement );
+
+    bool access( unsigned long long block );
+    void fill( unsigned long long block );
+    int capacity() const;
+    long long hits() const;
+    long long misses() const;
+
+private:
+    struct Frame
+    {
+        unsigned long long Block;
+        bool Referenced;
+    };
+
+    bool touchLRU( unsigned long long block );
+    void insertLRU( unsigned long long block );
+    bool touchClock( unsigned long long block );
+    void insertClock( unsigned long long block );
+
+    int m_capacity;
+    bool m_clock;
+    long long m_hits;
+    long long m_misses;
+
+    typedef std::list< unsigned long long,
+        PoolAllocator<unsigned long long> > Recency;
+    typedef std::unordered_map< unsigned long long, Recency::iterator,
+        std::hash<unsigned long long>, std::equal_to<unsigned long long>,
+        PoolAllocator< std::pair<const unsigned long long,
+        Recency::iterator> > > RecencyIndex;
+    typedef std::unordered_map< unsigned long long, int,
+        std::hash<unsigned long long>, std::equal_to<unsigned long long>,
+        PoolAllocator< std::pair<const unsigned long long, int> > >
+        FrameIndex;
+
+    // LRU, the most recently used block is at the front
+    Recency m_recent;
+    RecencyIndex m_recentIndex;
+
+    // CLOCK, the frame of every cached block
+    std::vector<Frame> m_frames;
+    FrameIndex m_frameIndex;
+    int m_hand;
+};
+
+#endif  //  BUFFERCACHE_H
@@ -0,0 +1,602 @@
+#include "device.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for a first come first served device.
+ *
+ * @param[in]  name       The name operations use for this device, such as
+ * "hard drive".
+ * @param[in]  instances  The number of requests it can serve at once.
+ * @param[in]  setupTime  The time in ms every request spends before its
+ * transfer.
+ */
+Device::Device( std::string name, int instances, int setupTime )
+    :   m_name( name ), m_setupTime( std::max( setupTime, 0 ) ),
+        m_ordering( Ordering::FirstComeFirstServed ),
+        m_cylinders( 0 ), m_seekTime( 0 ), m_rotationalLatency( 0 ),
+        m_clock( 0 ), m_cache( 0, "LRU" ), m_cacheHitTime( 0 ),
+        m_blocks( 1 ), m_spoolSlots( 0 ), m_spoolUsed( 0 ), m_requests( 0 ),
+        m_busyTime( 0 ), m_waitTime( 0 ), m_seekDistance( 0 ),
+        m_maxQueueDepth( 0 ), m_cacheSavedTime( 0 ), m_spooledRequests( 0 ),
+        m_spoolFull( 0 ), m_spoolSavedTime( 0 ), m_maxSpoolUsed( 0 )
+{
+    m_instances.resize( std::max( instances, 1 ), Instance{ 0, 0, 1 } );
+}
+
+/**
+ * @brief      Turns this device into a disk with the config's geometry and
+ * scheduling policy. A config without cylinders leaves the device as is.
+ *
+ * @param[in]  config  The configuration of the simulation.
+ */
+void Device::setDisk( const Config& config )
+{
+    if( config.cylinders <= 0 )
+        return;
+
+    m_cylinders = config.cylinders;
+    m_seekTime = config.seekTime;
+    m_rotationalLatency = config.rotationalLatency;
+
+    if( config.diskScheduling == "SSTF" )
+        m_ordering = Ordering::ShortestSeekTimeFirst;
+    else if( config.diskScheduling == "SCAN" )
+        m_ordering = Ordering::Scan;
+    else if( config.diskScheduling == "C-LOOK" )
+        m_ordering = Ordering::CircularLook;
+    else
+        m_ordering = Ordering::FirstComeFirstServed;
+}
+
+/**
+ * @brief      Puts a buffer cache with the config's capacity and replacement
+ * policy in front of this device. A config without cache blocks leaves the
+ * device as is.
+ *
+ * @param[in]  config  The configuration of the simulation.
+ */
+void Device::setCache( const Config& config )
+{
+    if( config.bufferCacheBlocks <= 0 )
+        return;
+
+    m_cache = BufferCache( config.bufferCacheBlocks,
+        config.bufferCacheReplacement );
+    m_replacement = config.bufferCacheReplacement == "CLOCK" ? "CLOCK" : "LRU";
+    m_cacheHitTime = config.bufferCacheHitTime;
+    m_blocks = std::max( config.diskBlocks, 1 );
+}
+
+/**
+ * @brief      Gives this device a spool for its output.
+ *
+ * @param[in]  slots  The number of requests the spool holds, 0 leaves the
+ * device without a spool.
+ */
+void Device::setSpool( int slots )
+{
+    m_spoolSlots = std::max( slots, 0 );
+}
+
+//
+// REQUESTS ////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Gives a request to this device, requests must be submitted in
+ * order of time.
+ *
+ * @param[in]  request  The request.
+ */
+void Device::submit( const Request& request )
+{
+    m_incoming.push_back( request );
+}
+
+/**
+ * @brief      Serves requests until the given time.
+ * @details    A request can only be chosen once every request made before the
+ * choice is known, so choices at or after the given time wait for the next
+ * call, as do submitted requests made at or after it. Every request made
+ * before the given time must have been submitted.
+ *
+ * @param[in]  until      The time in ms every earlier request has been
+ * submitted by.
+ * @param      completed  Receives every request that started service, with
+ * its completion time, and every spooled request with the time its
+ * application continues, each with the time it was decided.
+ */
+void Device::advance( long long until, std::vector<Request>& completed )
+{
+    while( true )
+    {
+        Instance& instance = m_instances[ earliestInstance() ];
+        long long nextArrival = m_incoming.empty() ? -1 :
+            m_incoming.front().Time;
+
+        // Serve the queue while an instance frees before the next arrival
+        if( waiting() > 0 )
+        {
+            long long decision = std::max( instance.FreeAt, m_clock );
+            if( decision < until &&
+                ( nextArrival < 0 || decision < nextArrival ) )
+            {
+                m_clock = decision;
+
+                long long distance = 0;
+                Request request = take( instance, distance );
+                long long serviceTime = m_setupTime + request.TransferTime;
+                if( m_cylinders > 0 )
+                {
+                    serviceTime += ( distance * m_seekTime + 500 ) / 1000 +
+                        m_rotationalLatency;
+                }
+
+                request.Completion = decision + serviceTime;
+                request.Decided = decision;
+                instance.FreeAt = request.Completion;
+
+                m_requests++;
+                m_busyTime += serviceTime;
+                m_waitTime += decision - request.Time;
+                m_seekDistance += distance;
+
+                // A missed block is cached once its read completes
+                if( request.Input && m_cache.capacity() > 0 )
+                {
+                    m_cacheFills.push( Fill( request.Completion, 
+                        block( request.Address ) ) );
+                }
+
+                // The application of a spooled request has already continued
+                if( request.Spooled )
+                {
+                    m_spoolDrains.push( request.Completion );
+                    m_spoolSavedTime += request.Completion - request.Time;
+                }
+                else
+                {
+                    completed.push_back( request );
+                }
+                continue;
+            }
+        }
+
+        if( nextArrival < 0 || nextArrival >= until )
+            break;
+
+        // The next request joins the queue, unless the cache serves it
+        m_clock = nextArrival;
+        Request request = m_incoming.front();
+        m_incoming.pop_front();
+
+        if( request.Input && m_cache.capacity() > 0 && cached( request ) )
+        {
+            request.Completion = request.Time + m_cacheHitTime;
+            request.Decided = request.Time;
+            m_cacheSavedTime += std::max( request.TransferTime -
+                m_cacheHitTime, 0LL );
+            completed.push_back( request );
+            continue;
+        }
+
+        if( !( request.Input ) && spool( request ) )
+        {
+            request.Spooled = true;
+            Request released = request;
+            released.Completion = request.Time;
+            released.Decided = request.Time;
+            completed.push_back( released );
+        }
+
+        if( m_ordering == Ordering::FirstComeFirstServed )
+            m_queue.push_back( request );
+        else
+            m_cylinderQueue.insert( std::make_pair(
+                static_cast<long long>( request.Address % m_cylinders ),
+                request ) );
+
+        if( instance.FreeAt > m_clock )
+            m_maxQueueDepth = std::max( m_maxQueueDepth, waiting() );
+    }
+}
+
+/**
+ * @brief      The time this device next serves a request, if nothing else is
+ * submitted before then.
+ *
+ * @return     The time in ms, or -1 if the queue is empty.
+ */
+long long Device::nextDecision() const
+{
+    if( waiting() == 0 )
+        return -1;
+    return std::max( m_instances[ earliestInstance() ].FreeAt, m_clock );
+}
+
+/**
+ * @brief      The shortest time a request can take from being made to its
+ * completion, a cache hit or else the setup and transfer.
+ *
+ * @param[in]  transferTime  The shortest transfer time of any request.
+ *
+ * @return     The time in ms.
+ */
+long long Device::shortestService( long long transferTime ) const
+{
+    long long service = m_setupTime + transferTime;
+    if( m_cache.capacity() > 0 )
+        service = std::min( service, static_cast<long long>( m_cacheHitTime ) );
+    return service;
+}
+
+/**
+ * @brief      Whether a request may complete the instant it is made, because
+ * it takes no time or is output this device may spool.
+ *
+ * @param[in]  transferTime  The transfer time of the request.
+ * @param[in]  input         Whether the request is an input.
+ *
+ * @return     True if it may complete at once, false otherwise.
+ */
+bool Device::completesAtOnce( long long transferTime, bool input ) const
+{
+    if( !( input ) && spools() )
+        return true;
+
+    long long service = m_setupTime + transferTime;
+    if( input && m_cache.capacity() > 0 )
+        service = std::min( service, static_cast<long long>( m_cacheHitTime ) );
+    return service == 0;
+}
+
+/**
+ * @brief      Whether this device has a spool for its output.
+ *
+ * @return     True if it has spool slots, false otherwise.
+ */
+bool Device::spools() const
+{
+    return m_spoolSlots > 0;
+}
+
+//
+// STATISTICS //////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Counts how many requests are waiting and how many instances are
+ * busy, the device must have advanced until this time.
+ *
+ * @param[in]  time  The time in ms to sample at.
+ *
+ * @return     The sample.
+ */
+Device::Sample Device::sample( long long time ) const
+{
+    int busy = 0;
+    for( size_t instance = 0; instance < m_instances.size(); instance++ )
+    {
+        if( m_instances[ instance ].FreeAt > time )
+            busy++;
+    }
+    return Sample{ time, waiting(), busy };
+}
+
+/**
+ * @brief      Logs a sample of this device.
+ *
+ * @param[in]  sample  A sample taken by sample().
+ */
+void Device::logSample( const Sample& sample ) const
+{
+    logger << sample.Time / 1000.0f << " - Device " << m_name
+        << ": queue depth " << sample.Waiting << ", busy " << sample.Busy
+        << " of " << static_cast<int>( m_instances.size() ) << "\n";
+}
+
+/**
+ * @brief      Logs the utilization and queueing of this device.
+ *
+ * @param[in]  end  The time in ms the simulation ended.
+ */
+void Device::report( long long end ) const
+{
+    int instances = m_instances.size();
+    float utilization = end > 0 ?
+        100.0f * m_busyTime / ( static_cast<float>( end ) * instances ) :
+        0.0f;
+    float meanWait = m_requests > 0 ?
+        static_cast<float>( m_waitTime ) / m_requests : 0.0f;
+    // Little's law, the mean number waiting is the total wait over time
+    float meanDepth = end > 0 ? static_cast<float>( m_waitTime ) / end : 0.0f;
+
+    logger << "    Device " << m_name << " (" << instances << "): "
+        << "utilization " << utilization << "%, requests "
+        << static_cast<int>( m_requests ) << ", mean wait " << meanWait
+        << " ms, mean queue depth " << meanDepth << ", max queue depth "
+        << m_maxQueueDepth;
+
+    if( m_cylinders > 0 )
+    {
+        float meanSeek = m_requests > 0 ?
+            static_cast<float>( m_seekDistance ) / m_requests : 0.0f;
+        logger << ", mean seek " << meanSeek << " cylinders";
+    }
+
+    if( m_cache.capacity() > 0 )
+    {
+        long long lookups = m_cache.hits() + m_cache.misses();
+        float hitRate = lookups > 0 ?
+            100.0f * m_cache.hits() / lookups : 0.0f;
+        logger << ", " << m_replacement << " cache of " << m_cache.capacity()
+            << " blocks hit rate " << hitRate << "%, saved "
+            << static_cast<float>( m_cacheSavedTime / 1000.0 ) << " s";
+    }
+
+    if( m_spoolSlots > 0 )
+    {
+        logger << ", spooled " << static_cast<int>( m_spooledRequests )
+            << " saving " << static_cast<float>( m_spoolSavedTime / 1000.0 )
+            << " s blocked, spool full " << static_cast<int>( m_spoolFull )
+            << " times, max " << m_maxSpoolUsed << " of " << m_spoolSlots
+            << " slots";
+    }
+    logger << "\n";
+}
+
+//
+// HELPER FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Builds every device with the instance counts of the config, in
+ * the order of Device::index(). The hard drive uses the config's disk model.
+ *
+ * @param[in]  config  The configuration of the simulation.
+ *
+ * @return     The hard drive, keyboard, monitor, and printer devices.
+ */
+std::vector<Device> Device::fromConfig( const Config& config )
+{
+    std::vector<Device> devices;
+    devices.push_back( Device( "hard drive", config.hardDrives,
+        config.hardDriveSetup ) );
+    devices.push_back( Device( "keyboard", config.keyboards,
+        config.keyboardSetup ) );
+    devices.push_back( Device( "monitor", config.monitors,
+        config.monitorSetup ) );
+    devices.push_back( Device( "printer", config.printers,
+        config.printerSetup ) );
+
+    devices[ 0 ].setDisk( config );
+    devices[ 0 ].setCache( config );
+    devices[ 2 ].setSpool( config.monitorSpool );
+    devices[ 3 ].setSpool( config.printerSpool );
+    return devices;
+}
+
+/**
+ * @brief      Finds the device an operation uses.
+ *
+ * @param[in]  name  The name of the operation, such as "hard drive".
+ *
+ * @return     The index of the device, or -1 if no device has that name.
+ */
+int Device::index( const std::string& name )
+{
+    if( name == "hard drive" )
+        return 0;
+    else if( name == "keyboard" )
+        return 1;
+    else if( name == "monitor" )
+        return 2;
+    else if( name == "printer" )
+        return 3;
+    return -1;
+}
+
+/**
+ * @brief      Finds the instance that is free first, the lowest on ties.
+ *
+ * @return     The index of the instance.
+ */
+int Device::earliestInstance() const
+{
+    int earliest = 0;
+    for( size_t instance = 1; instance < m_instances.size(); instance++ )
+    {
+        if( m_instances[ instance ].FreeAt < m_instances[ earliest ].FreeAt )
+            earliest = instance;
+    }
+    return earliest;
+}
+
+/**
+ * @brief      The number of requests waiting in the queue.
+ *
+ * @return     The queue depth.
+ */
+int Device::waiting() const
+{
+    return m_queue.size() + m_cylinderQueue.size();
+}
+
+/**
+ * @brief      The block an address is stored in.
+ * @details    Eight in ten addresses fall in the hottest fifth of the blocks,
+ * so a cache much smaller than the disk still finds some blocks again.
+ *
+ * @param[in]  address  The address of an operation.
+ *
+ * @return     The block number, below the number of disk blocks.
+ */
+unsigned long long Device::block( unsigned long long address ) const
+{
+    unsigned long long hotBlocks = std::max( m_blocks / 5, 1LL );
+    if( ( address >> 32 ) % 10 < 8 )
+        return address % hotBlocks;
+    return address % m_blocks;
+}
+
+/**
+ * @brief      Looks up an input request's block in the cache, after caching
+ * every block whose read has completed by the request's time.
+ *
+ * @param[in]  request  The input request, at the device's current time.
+ *
+ * @return     True if the block is cached, false otherwise.
+ */
+bool Device::cached( const Request& request )
+{
+    while( !( m_cacheFills.empty() ) &&
+        m_cacheFills.top().first <= request.Time )
+    {
+        m_cache.fill( m_cacheFills.top().second );
+        m_cacheFills.pop();
+    }
+    return m_cache.access( block( request.Address ) );
+}
+
+/**
+ * @brief      Takes a spool slot for an output request if one is free, slots
+ * of spooled output that has completed by the request's time are free again.
+ *
+ * @param[in]  request  The output request, at the device's current time.
+ *
+ * @return     True if the request was spooled, false if the device has no
+ * spool or every slot is taken.
+ */
+bool Device::spool( const Request& request )
+{
+    if( m_spoolSlots == 0 )
+        return false;
+
+    while( !( m_spoolDrains.empty() ) && m_spoolDrains.top() <= request.Time )
+    {
+        m_spoolDrains.pop();
+        m_spoolUsed--;
+    }
+
+    if( m_spoolUsed == m_spoolSlots )
+    {
+        m_spoolFull++;
+        return false;
+    }
+
+    m_spoolUsed++;
+    m_spooledRequests++;
+    m_maxSpoolUsed = std::max( m_maxSpoolUsed, m_spoolUsed );
+    return true;
+}
+
+/**
+ * @brief      Removes the request an instance serves next from the queue and
+ * moves the instance's head to it.
+ *
+ * @param      instance  The instance that is free.
+ * @param[out] distance  The cylinders the head travels.
+ *
+ * @return     The request to serve.
+ */
+Device::Request Device::take( Instance& instance, long long& distance )
+{
+    if( m_ordering == Ordering::FirstComeFirstServed )
+    {
+        Request request = m_queue.front();
+        m_queue.pop_front();
+
+        if( m_cylinders > 0 )
+        {
+            long long cylinder = request.Address % m_cylinders;
+            distance = std::llabs( cylinder - instance.Head );
+            instance.Head = cylinder;
+        }
+        return request;
+    }
+
+    CylinderQueue::iterator next;
+    CylinderQueue::iterator above =
+        m_cylinderQueue.lower_bound( instance.Head );
+
+    if( m_ordering == Ordering::ShortestSeekTimeFirst )
+    {
+        // The closest request below the head wins ties with the one above
+        next = above;
+        if( above == m_cylinderQueue.end() || ( above != m_cylinderQueue.begin()
+            && instance.Head - std::prev( above )->first <=
+               above->first - instance.Head ) )
+        {
+            next = first( std::prev( above )->first );
+        }
+        distance = std::llabs( next->first - instance.Head );
+    }
+    else if( m_ordering == Ordering::Scan )
+    {
+        // Sweep to the end of the disk before reversing
+        if( instance.Direction > 0 )
+        {
+            if( above != m_cylinderQueue.end() )
+            {
+                next = above;
+                distance = next->first - instance.Head;
+            }
+            else
+            {
+                next = first( std::prev( above )->first );
+                distance = ( m_cylinders - 1 - instance.Head ) +
+                    ( m_cylinders - 1 - next->first );
+                instance.Direction = -1;
+            }
+        }
+        else
+        {
+            CylinderQueue::iterator below =
+                m_cylinderQueue.upper_bound( instance.Head );
+            if( below != m_cylinderQueue.begin() )
+            {
+                next = first( std::prev( below )->first );
+                distance = instance.Head - next->first;
+            }
+            else
+            {
+                next = m_cylinderQueue.begin();
+                distance = instance.Head + next->first;
+                instance.Direction = 1;
+            }
+        }
+    }
+    else
+    {
+        // Only sweep upward, jumping back to the lowest request at the top
+        next = above;
+        if( next == m_cylinderQueue.end() )
+            next = m_cylinderQueue.begin();
+        distance = std::llabs( next->first - instance.Head );
+    }
+
+    Request request = next->second;
+    instance.Head = next->first;
+    m_cylinderQueue.erase( next );
+    return request;
+}
+
+/**
+ * @brief      Finds the earliest request on a cylinder.
+ *
+ * @param[in]  cylinder  A cylinder with at least one request.
+ *
+ * @return     The request that was queued first on that cylinder.
+ */
+Device::CylinderQueue::iterator Device::first(
+    long long cylinder )
+{
+    return m_cylinderQueue.lower_bound( cylinder );
+}
@@ -0,0 +1,153 @@
+#ifndef DEVICE_H
+#define DEVICE_H
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "Tools/config.h"
+#include "Tools/log.h"
+#include "Tools/pool.h"
+
+#include "application.h"
+#include "buffercache.h"
+
+/**
+ * @brief      An I/O device with one or more identical instances shared by
+ * every application. A request waits in the device's queue while every
+ * instance is busy.
+ * @details    A device with cylinders models a disk: every request is placed
+ * on the cylinder its operation's address maps to, each instance has its own
+ * head, and a request costs the seek from the head to its cylinder plus the
+ * rotational latency before its transfer. The disk scheduling policy then
+ * orders the queue, any other device is first come first served.
+ *
+ * A device with a buffer cache serves an input whose block is cached in the
+ * cache's hit time, without queueing for an instance. A block that misses is
+ * cached when its read completes, so a read made while it is still in flight
+ * misses too. Output is written
+ * straight to the device.
+ *
+ * A device with a spool copies output into one of its spool slots and lets
+ * the application continue at once, the spooled output then drains at the
+ * device's own speed and frees its slot when it completes. Output that finds
+ * every slot taken blocks the application until it is served.
+ *
+ * Every request served by an instance pays the device's setup time before its
+ * transfer.
+ */
+class Device
+{
+public:
+    struct Request
+    {
+        long long Time;
+        long long TransferTime;
+        unsigned long long Address;
+        bool Input;
+        int Processor;
+        Application* App;
+        long long Completion;
+        long long Decided;
+        bool Spooled;
+
+        bool operator<( const Request& other ) const
+        {
+            return Time < other.Time;
+        }
+    };
+
+    struct Sample
+    {
+        long long Time;
+        int Waiting;
+        int Busy;
+    };
+
+    Device( std::string name, int instances, int setupTime );
+
+    void setDisk( const Config& config );
+    void setCache( const Config& config );
+    void setSpool( int slots );
+    void submit( const Request& request );
+    void advance( long long until, std::vector<Request>& completed );
+    long long nextDecision() const;
+    long long shortestService( long long transferTime ) const;
+    bool completesAtOnce( long long transferTime, bool input ) const;
+    bool spools() const;
+    Sample sample( long long time ) const;
+    void logSample( const Sample& sample ) const;
+    void report( long long end ) const;
+
+    static std::vector<Device> fromConfig( const Config& config );
+    static int index( const std::string& name );
+
+private:
+    // Requests waiting for a disk, by the cylinder they are on
+    typedef std::multimap< long long, Request, std::less<long long>,
+        PoolAllocator< std::pair<const long long, Request> > > CylinderQueue;
+
+    // The time a missed block's read completes, and the block
+    typedef std::pair<long long, unsigned long long> Fill;
+
+    enum class Ordering
+    {
+        FirstComeFirstServed,
+        ShortestSeekTimeFirst,
+        Scan,
+        CircularLook
+    };
+
+    struct Instance
+    {
+        long long FreeAt;
+        long long Head;
+        int Direction;
+    };
+
+    int earliestInstance() const;
+    int waiting() const;
+    unsigned long long block( unsigned long long address ) const;
+    bool cached( const Request& request );
+    bool spool( const Request& request );
+    Request take( Instance& instance, long long& distance );
+    CylinderQueue::iterator first( long long cylinder );
+
+    std::string m_name;
+    std::vector<Instance> m_instances;
+    int m_setupTime;
+    Ordering m_ordering;
+    long long m_cylinders;
+    int m_seekTime;
+    int m_rotationalLatency;
+    long long m_clock;
+    std::deque< Request, PoolAllocator<Request> > m_incoming;
+    std::deque< Request, PoolAllocator<Request> > m_queue;
+    CylinderQueue m_cylinderQueue;
+    BufferCache m_cache;
+    std::string m_replacement;
+    int m_cacheHitTime;
+    long long m_blocks;
+    int m_spoolSlots;
+    int m_spoolUsed;
+    std::priority_queue<long long, std::vector<long long>,
+        std::greater<long long> > m_spoolDrains;
+    std::priority_queue<Fill, std::vector<Fill>, std::greater<Fill> >
+        m_cacheFills;
+
+    long long m_requests;
+    long long m_busyTime;
+    long long m_waitTime;
+    long long m_seekDistance;
+    int m_maxQueueDepth;
+    long long m_cacheSavedTime;
+    long long m_spooledRequests;
+    long long m_spoolFull;
+    long long m_spoolSavedTime;
+    int m_maxSpoolUsed;
+};
+
+#endif  //  DEVICE_H
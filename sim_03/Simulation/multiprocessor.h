@@ -0,0 +1,1091 @@
+#ifndef MULTIPROCESSOR_H
+#define MULTIPROCESSOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "Tools/allocations.h"
+#include "Tools/config.h"
+#include "Tools/log.h"
+#include "Tools/timingwheel.h"
+#include "Tools/workers.h"
+
+#include "application.h"
+#include "device.h"
+
+/**
+ * @brief      Simulates several processors sharing the applications, each
+ * processor with its own ready queue.
+ * @details    The simulation keeps its own clock in ms and advances it from
+ * event to event, nothing sleeps. An application blocks while its I/O
+ * completes and then returns to the processor it last ran on. Every device is
+ * shared, an I/O request waits in the device's queue while all of its
+ * instances are busy.
+ *
+ * Time is divided into windows. A window starts at the earliest pending
+ * event or device decision and lasts at most one lookahead, the shortest time
+ * an I/O request can take, but ends by the first instant a processor could go
+ * idle while another has ready applications, or gain ready applications while
+ * another is idle. Within a window every processor only touches its own
+ * events, ready queue, and applications, so the processors of a window run in
+ * parallel on the host threads. Processors interact in the last instant of a
+ * window: devices serve the window's I/O requests in order of time and then
+ * processor, and idle processors steal the application that would run last
+ * on the processor with the most ready applications. The stolen application
+ * keeps its place in the policy, such as its level, virtual runtime or pass
+ * rebased to the new queue, and pays the migration cost before it runs. With "Affinity" placement a processor only steals when the victim's
+ * backlog outweighs warming a cold cache.
+ *
+ * A processor therefore steals at the very instant it goes idle with work
+ * available, exactly as if every window were a single instant, which is what
+ * "Synchronization: Sequential" runs on one host thread as a reference.
+ *
+ * Every application remembers the processor and time it last ran. Its cache
+ * on that processor cools with the configured half-life, and every burst pays
+ * the cache warm-up cycles in proportion to how cold its cache is, a burst on
+ * a different processor always starts cold. Log records are merged by time
+ * and then processor, so the results do not depend on the number of host
+ * threads.
+ *
+ * Pending events are kept in a binary heap, or in a timing wheel when built
+ * with TIMING_WHEEL defined.
+ *
+ * @tparam     Policy  The scheduling policy of every ready queue, see
+ * scheduler.h.
+ */
+template <typename Policy>
+class MultiProcessor
+{
+public:
+    MultiProcessor( const Config& config, ApplicationList& applications,
+        const OperationTable& operations );
+    void run();
+
+private:
+    // The end of the running burst is kept by its processor
+    enum class EventType
+    {
+        IOComplete,
+        Arrival
+    };
+
+    enum class RecordType
+    {
+        BurstStart,
+        BurstEnd,
+        IOStart,
+        IOEnd
+    };
+
+    struct Event
+    {
+        long long Time;
+        long long Sequence;
+        EventType Type;
+        Application* App;
+
+        bool operator<( const Event& other ) const
+        {
+            // std::priority_queue keeps the greatest element on top, events
+            // at the same time run in the order they were scheduled
+            if( Time != other.Time )
+                return Time > other.Time;
+            return Sequence > other.Sequence;
+        }
+    };
+
+#ifdef TIMING_WHEEL
+    typedef TimingWheel<Event> EventQueue;
+#else
+    typedef std::priority_queue<Event> EventQueue;
+#endif
+
+    struct Request
+    {
+        int Device;
+        Device::Request Data;
+
+        bool operator<( const Request& other ) const
+        {
+            return Data < other.Data;
+        }
+    };
+
+    struct Record
+    {
+        long long Time;
+        RecordType Type;
+        int Processor;
+        int AppID;
+        const std::string* Operation;
+        bool Input;
+
+        bool operator<( const Record& other ) const
+        {
+            return Time < other.Time;
+        }
+    };
+
+    struct Processor
+    {
+        Processor( const Config& config )
+            :   Ready( config ), ReadyCount( 0 ), ReadyProcessing( 0 ),
+                Running( nullptr ), Result( BurstResult::QuantumExpired ),
+                BurstEnd( 0 ), Now( 0 ), Sequence( 0 ), Completed( 0 ),
+                BusyTime( 0 ), Bursts( 0 ), Steals( 0 ), Migrations( 0 ),
+                WarmupTime( 0 )
+        {
+        }
+
+        Policy Ready;
+        int ReadyCount;
+        int ReadyProcessing;
+        Application* Running;
+        BurstResult Result;
+        long long BurstEnd;
+        long long Now;
+        long long Sequence;
+        int Completed;
+        EventQueue Events;
+        std::vector<Request> Requests;
+        std::vector<Record> Records;
+        long long BusyTime;
+        long long Bursts;
+        long long Steals;
+        long long Migrations;
+        long long WarmupTime;
+    };
+
+    void runWindow( int processor, long long windowEnd );
+    void serveRequests( Workers& workers, long long windowEnd );
+    void balance( long long time );
+    bool pending( long long windowEnd ) const;
+    void flushRecords();
+    void logSamples( size_t sample ) const;
+    template <typename Item>
+    void merge( std::vector<Item> Processor::* items,
+        std::vector<Item>& merged );
+    void schedule( int processor, long long time, EventType type,
+        Application* app );
+    void record( int processor, RecordType type, const Application* app );
+    void countReady( Processor& cpu, const Application* app, int change );
+    void dispatch( int processor );
+    int findVictim( int thief ) const;
+    bool worthStealing( int victim ) const;
+    long long warmupCycles( const Application* app, int processor ) const;
+    void endBurst( int processor );
+    void completeIO( int processor, const Event& event );
+    void arrive( int processor, const Event& event );
+    long long earliestTime() const;
+    long long interaction() const;
+    bool completesAtOnce( const Application* app ) const;
+    long long shortestRequest( const OperationTable& operations ) const;
+    void report() const;
+
+    Config m_config;
+    bool m_logEvents;
+    int m_remaining;
+    long long m_lookahead;
+    bool m_atOnce;
+    long long m_sampled;
+    std::vector<Processor> m_processors;
+    std::vector<Device> m_devices;
+    std::vector<int> m_lastProcessor;
+    std::vector<long long> m_lastRun;
+
+    // Kept between windows so that a window reuses their memory
+    std::vector< std::vector<Device::Request> > m_queues;
+    std::vector< std::vector<Device::Request> > m_submitted;
+    std::vector<Request> m_requests;
+    std::vector<Record> m_records;
+    std::vector<size_t> m_cursors;
+    std::vector< std::vector<Device::Sample> > m_samples;
+};
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Builds the processors and deals the applications between their
+ * ready queues in order of arrival.
+ * @details    An application with an arrival time is only dealt its processor
+ * here, it joins the ready queue when it arrives.
+ *
+ * @param[in]  config        The configuration associated with this simulation.
+ * @param      applications  The applications to simulate, they must outlive
+ * this MultiProcessor.
+ * @param[in]  operations    Every operation of the applications.
+ */
+template <typename Policy>
+MultiProcessor<Policy>::MultiProcessor( const Config& config,
+    ApplicationList& applications, const OperationTable& operations )
+    :   m_config( config ), m_logEvents( config.logLevel == "Events" ),
+        m_remaining( 0 ), m_lookahead( 0 ), m_atOnce( false ),
+        m_sampled( 0 ),
+        m_devices( Device::fromConfig( config ) ),
+        m_queues( m_devices.size() + 1 ), m_submitted( m_devices.size() ),
+        m_samples( m_devices.size() )
+{
+    // Without I/O only the processors bound a window
+    long long shortest = shortestRequest( operations );
+    m_lookahead = std::max( shortest < 0 ?
+        static_cast<long long>( m_config.processorCycle ) : shortest, 1LL );
+
+    // Spooled output and requests that take no time complete at once
+    m_atOnce = shortest == 0;
+    for( size_t device = 0; device < m_devices.size(); device++ )
+        m_atOnce = m_atOnce || m_devices[ device ].spools();
+
+    int processorCount = std::max( m_config.processors, 1 );
+    m_processors.reserve( processorCount );
+    for( int processor = 0; processor < processorCount; processor++ )
+        m_processors.push_back( Processor( m_config ) );
+
+    int processor = 0;
+    for( size_t index = 0; index < applications.size(); index++ )
+    {
+        Application* app = &( applications[ index ] );
+        if( app->getID() >= static_cast<int>( m_lastProcessor.size() ) )
+        {
+            m_lastProcessor.resize( app->getID() + 1, 0 );
+            m_lastRun.resize( app->getID() + 1, -1 );
+        }
+
+        m_lastProcessor[ app->getID() ] = processor;
+        if( app->Arrival > 0 )
+        {
+            schedule( processor, app->Arrival, EventType::Arrival, app );
+        }
+        else
+        {
+            m_processors[ processor ].Ready.enqueue( app );
+            countReady( m_processors[ processor ], app, 1 );
+        }
+        m_remaining++;
+
+        processor = ( processor + 1 ) % processorCount;
+    }
+}
+
+//
+// MAIN SIMULATION LOOP ////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Runs every application to completion one window at a time,
+ * then logs how each processor was used.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::run()
+{
+    // The sequential reference runs one instant at a time on one host thread
+    bool sequential = m_config.synchronization == "Sequential";
+    Workers workers( sequential ? 1 : std::min( std::max( 
+        m_config.hostThreads, 1 ), static_cast<int>( m_processors.size() ) ) );
+    long long window = m_lookahead;
+
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+        dispatch( processor );
+    balance( 0 );
+
+    // Counted allocations, see allocations.h
+    unsigned long long allocations = Allocations::count();
+    long long windows = 0;
+    long long allocatingWindows = 0;
+    long long lastAllocatingWindow = 0;
+
+    while( m_remaining > 0 )
+    {
+        unsigned long long windowAllocations = Allocations::count();
+
+        // Skip ahead to the earliest event or device decision, nothing can
+        // change before it
+        long long earliest = earliestTime();
+        if( earliest < 0 )
+            break;
+
+        long long windowEnd = earliest + 1;
+        if( !( sequential ) )
+        {
+            long long last = interaction();
+            windowEnd = last < 0 ? earliest + window :
+                std::min( earliest + window, last + 1 );
+        }
+
+        // Applications stolen in the window's last instant may run and
+        // request I/O within that instant too
+        do
+        {
+            workers.run( m_processors.size(), [this, windowEnd]( 
+                int processor ) {
+                runWindow( processor, windowEnd );
+            } );
+
+            serveRequests( workers, windowEnd );
+            balance( windowEnd - 1 );
+        }
+        while( pending( windowEnd ) );
+        flushRecords();
+
+        windows++;
+        if( Allocations::count() != windowAllocations )
+        {
+            allocatingWindows++;
+            lastAllocatingWindow = windows;
+        }
+    }
+
+    report();
+
+    if( Allocations::enabled() )
+    {
+        logger << "    Allocations: " << static_cast<int>( 
+            Allocations::count() - allocations ) << " in "
+            << static_cast<int>( allocatingWindows ) << " of " 
+            << static_cast<int>( windows ) << " windows, the last in window "
+            << static_cast<int>( lastAllocatingWindow ) << "\n";
+    }
+}
+
+/**
+ * @brief      Runs one processor's events and burst ends that happen before
+ * the end of the window. Only state owned by this processor is touched.
+ *
+ * @param[in]  processor  The processor to run.
+ * @param[in]  windowEnd  The time in ms the window ends at.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::runWindow( int processor, long long windowEnd )
+{
+    Processor& cpu = m_processors[ processor ];
+
+    while( true )
+    {
+        bool event = !( cpu.Events.empty() ) &&
+            cpu.Events.top().Time < windowEnd;
+        bool burst = cpu.Running != nullptr && cpu.BurstEnd < windowEnd;
+        if( !( event ) && !( burst ) )
+            break;
+
+        // Completions and arrivals at the time a burst ends come first
+        if( event && ( !( burst ) || cpu.Events.top().Time <= cpu.BurstEnd ) )
+        {
+            Event next = cpu.Events.top();
+            cpu.Events.pop();
+            cpu.Now = next.Time;
+
+            if( next.Type == EventType::IOComplete )
+                completeIO( processor, next );
+            else
+                arrive( processor, next );
+        }
+        else
+        {
+            cpu.Now = cpu.BurstEnd;
+            endBurst( processor );
+        }
+    }
+}
+
+/**
+ * @brief      Gives the window's I/O requests to their devices and lets every
+ * device serve its queue until the end of the window, then schedules every
+ * completion on the processor that made the request.
+ * @details    Each device is served on its own host thread, requests reach it
+ * in order of time and then processor. Devices are sampled at every multiple
+ * of the sample period within the window. Completions are scheduled in order
+ * of the time they were decided and then device, so that they are scheduled
+ * in the same order however long the window is. A request that completes at
+ * once, spooled or taking no time, is only made in the last instant of a
+ * window and completes within it, any other request completes after the
+ * window, since none is shorter than the lookahead.
+ *
+ * @param      workers    The host threads.
+ * @param[in]  windowEnd  The time in ms the window ends at.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::serveRequests( Workers& workers,
+    long long windowEnd )
+{
+    std::vector< std::vector<Device::Request> >& queues = m_queues;
+
+    // Operations on an unknown device are never kept waiting
+    merge( &Processor::Requests, m_requests );
+    for( size_t index = 0; index < m_requests.size(); index++ )
+    {
+        Device::Request& data = m_requests[ index ].Data;
+        if( m_requests[ index ].Device < 0 )
+        {
+            data.Completion = data.Time + data.TransferTime;
+            data.Decided = data.Time;
+            queues.back().push_back( data );
+        }
+        else
+        {
+            queues[ m_requests[ index ].Device ].push_back( data );
+        }
+    }
+    m_requests.clear();
+
+    workers.run( m_devices.size(), [this, windowEnd]( int device ) {
+        std::vector<Device::Request>& requests = m_submitted[ device ];
+        requests.swap( m_queues[ device ] );
+
+        for( size_t index = 0; index < requests.size(); index++ )
+            m_devices[ device ].submit( requests[ index ] );
+        requests.clear();
+
+        // Samples are due at every multiple of the period not yet sampled
+        long long period = m_config.deviceSamplePeriod;
+        long long time = period > 0 ?
+            std::max( ( m_sampled + period - 1 ) / period, 1LL ) * period : 0;
+        for( ; period > 0 && time < windowEnd; time += period )
+        {
+            m_devices[ device ].advance( time, m_queues[ device ] );
+            m_samples[ device ].push_back( m_devices[ device ].sample( 
+                time ) );
+        }
+        m_devices[ device ].advance( windowEnd, m_queues[ device ] );
+    } );
+    m_sampled = std::max( m_sampled, windowEnd );
+
+    m_cursors.assign( queues.size(), 0 );
+    while( true )
+    {
+        int next = -1;
+        for( size_t device = 0; device < queues.size(); device++ )
+        {
+            if( m_cursors[ device ] < queues[ device ].size() && ( next < 0 ||
+                queues[ device ][ m_cursors[ device ] ].Decided <
+                queues[ next ][ m_cursors[ next ] ].Decided ) )
+            {
+                next = device;
+            }
+        }
+        if( next < 0 )
+            break;
+
+        const Device::Request& request = queues[ next ][ m_cursors[ next ]++ ];
+        schedule( request.Processor, request.Completion,
+            EventType::IOComplete, request.App );
+    }
+
+    for( size_t device = 0; device < queues.size(); device++ )
+        queues[ device ].clear();
+}
+
+/**
+ * @brief      Ends the last instant of a window, counts completed applications
+ * and lets every idle processor steal an application from the busiest
+ * processor.
+ *
+ * @param[in]  time  The time in ms of the window's last instant.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::balance( long long time )
+{
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+    {
+        m_remaining -= m_processors[ processor ].Completed;
+        m_processors[ processor ].Completed = 0;
+    }
+
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+    {
+        Processor& cpu = m_processors[ processor ];
+        if( cpu.Running != nullptr || cpu.ReadyCount > 0 )
+            continue;
+
+        int victim = findVictim( processor );
+        if( victim < 0 || !( worthStealing( victim ) ) )
+            continue;
+
+        // The application that would run last on the victim is stolen, and
+        // joins this processor's policy with its place rebased, so the policy
+        // knows it when giving it a time slice
+        long long lag = 0;
+        Application* stolen = m_processors[ victim ].Ready.steal( lag );
+        countReady( m_processors[ victim ], stolen, -1 );
+        cpu.Ready.migrate( stolen, lag );
+        countReady( cpu, stolen, 1 );
+        cpu.Steals++;
+
+        cpu.Now = time;
+        dispatch( processor );
+    }
+}
+
+/**
+ * @brief      Whether any processor has an event or burst end left before the
+ * end of the window.
+ *
+ * @param[in]  windowEnd  The time in ms the window ends at.
+ *
+ * @return     True if the window must run again, false otherwise.
+ */
+template <typename Policy>
+bool MultiProcessor<Policy>::pending( long long windowEnd ) const
+{
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+    {
+        const Processor& cpu = m_processors[ processor ];
+        if( ( cpu.Running != nullptr && cpu.BurstEnd < windowEnd ) ||
+            ( !( cpu.Events.empty() ) && cpu.Events.top().Time < windowEnd ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief      Logs the records of every processor in order of time, records at
+ * the same time are logged in order of processor. Device samples are logged
+ * before the records at their time.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::flushRecords()
+{
+    std::vector<Record>& records = m_records;
+    merge( &Processor::Records, records );
+
+    // Every device is sampled at the same times
+    size_t sample = 0;
+    size_t samples = m_samples.front().size();
+
+    for( size_t index = 0; index < records.size(); index++ )
+    {
+        const Record& entry = records[ index ];
+        float time = entry.Time / 1000.0f;
+
+        for( ; sample < samples &&
+               m_samples.front()[ sample ].Time <= entry.Time; sample++ )
+        {
+            logSamples( sample );
+        }
+
+        if( entry.Type == RecordType::BurstStart ||
+            entry.Type == RecordType::BurstEnd )
+        {
+            logger << time << " - OS: "
+                << ( entry.Type == RecordType::BurstStart ? "START" : "END" )
+                << " process " << entry.AppID << " on processor "
+                << entry.Processor << "\n";
+        }
+        else
+        {
+            logger << time << " - Process " << entry.AppID << ": "
+                << ( entry.Type == RecordType::IOStart ? "START" : "END" )
+                << " " << *entry.Operation
+                << ( entry.Input ? " input\n" : " output\n" );
+        }
+    }
+    records.clear();
+
+    for( ; sample < samples; sample++ )
+        logSamples( sample );
+    for( size_t device = 0; device < m_samples.size(); device++ )
+        m_samples[ device ].clear();
+}
+
+/**
+ * @brief      Logs one sample of every device.
+ *
+ * @param[in]  sample  The index of the sample within the window.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::logSamples( size_t sample ) const
+{
+    for( size_t device = 0; device < m_devices.size(); device++ )
+        m_devices[ device ].logSample( m_samples[ device ][ sample ] );
+}
+
+/**
+ * @brief      Moves the requests or records of every processor into one list
+ * in order of time, those at the same time in order of processor.
+ * @details    Each processor adds its own in order of time, so this is a merge
+ * of sorted lists, which unlike a sort needs no memory of its own.
+ *
+ * @tparam     Item    Request or Record.
+ *
+ * @param[in]  items   The processor's list to take them from, which is left
+ * empty.
+ * @param[out] merged  The list to append them to.
+ */
+template <typename Policy>
+template <typename Item>
+void MultiProcessor<Policy>::merge( std::vector<Item> Processor::* items,
+    std::vector<Item>& merged )
+{
+    m_cursors.assign( m_processors.size(), 0 );
+
+    while( true )
+    {
+        int next = -1;
+        for( size_t processor = 0; processor < m_processors.size();
+             processor++ )
+        {
+            const std::vector<Item>& local = m_processors[ processor ].*items;
+            if( m_cursors[ processor ] < local.size() && ( next < 0 ||
+                local[ m_cursors[ processor ] ] <
+                ( m_processors[ next ].*items )[ m_cursors[ next ] ] ) )
+            {
+                next = processor;
+            }
+        }
+        if( next < 0 )
+            break;
+
+        merged.push_back( ( m_processors[ next ].*items )[
+            m_cursors[ next ]++ ] );
+    }
+
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+        ( m_processors[ processor ].*items ).clear();
+}
+
+//
+// EVENTS //////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Adds an event to a processor.
+ *
+ * @param[in]  processor  The processor the event belongs to.
+ * @param[in]  time       The simulation time in ms the event happens at.
+ * @param[in]  type       The kind of event.
+ * @param      app        The application the event belongs to.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::schedule( int processor, long long time,
+    EventType type, Application* app )
+{
+    Processor& cpu = m_processors[ processor ];
+    cpu.Events.push( Event{ time, cpu.Sequence++, type, app } );
+}
+
+/**
+ * @brief      Adds a log record to a processor at its current time.
+ *
+ * @param[in]  processor  The processor the record belongs to.
+ * @param[in]  type       The kind of record.
+ * @param[in]  app        The application the record belongs to.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::record( int processor, RecordType type,
+    const Application* app )
+{
+    // A summary log has no records to keep
+    if( !( m_logEvents ) )
+        return;
+
+    Processor& cpu = m_processors[ processor ];
+    bool io = type == RecordType::IOStart || type == RecordType::IOEnd;
+
+    // Operation names live in the operation table for the whole simulation
+    cpu.Records.push_back( Record{ cpu.Now, type, processor, app->getID(),
+        io ? &( app->getOperationName() ) : nullptr,
+        io && app->isInput() } );
+}
+
+/**
+ * @brief      Counts an application joining or leaving a processor's ready
+ * queue, and whether its next burst takes at least one processor cycle.
+ *
+ * @param      cpu     The processor.
+ * @param[in]  app     The application.
+ * @param[in]  change  1 if it joins, -1 if it leaves.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::countReady( Processor& cpu,
+    const Application* app, int change )
+{
+    cpu.ReadyCount += change;
+    if( app->isProcessing() )
+        cpu.ReadyProcessing += change;
+}
+
+/**
+ * @brief      Gives an idle processor the next application in its own ready
+ * queue, if it has one.
+ *
+ * @param[in]  processor  The idle processor.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::dispatch( int processor )
+{
+    Processor& cpu = m_processors[ processor ];
+    if( cpu.ReadyCount == 0 )
+        return;
+
+    Application* app = cpu.Ready.pickNext();
+    countReady( cpu, app, -1 );
+    record( processor, RecordType::BurstStart, app );
+
+    // Running on a different processor than last time costs a migration, and
+    // a cold cache costs warm-up cycles wherever it runs
+    long long warmup = warmupCycles( app, processor ) * m_config.processorCycle;
+    long long penalty = warmup;
+    if( m_lastProcessor[ app->getID() ] != processor )
+    {
+        penalty += static_cast<long long>( m_config.migrationCost ) *
+            m_config.processorCycle;
+        cpu.Migrations++;
+    }
+    m_lastProcessor[ app->getID() ] = processor;
+    cpu.WarmupTime += warmup;
+
+    int elapsedTime = 0;
+    cpu.Result = app->runProcessor( cpu.Ready.timeSlice( app ), elapsedTime );
+    cpu.Running = app;
+    cpu.BusyTime += penalty + elapsedTime;
+    cpu.Bursts++;
+    cpu.BurstEnd = cpu.Now + penalty + elapsedTime;
+}
+
+/**
+ * @brief      Finds the processor with the most ready applications.
+ *
+ * @param[in]  thief  The processor looking for work.
+ *
+ * @return     The processor to steal from, or -1 if no processor has a ready
+ * application.
+ */
+template <typename Policy>
+int MultiProcessor<Policy>::findVictim( int thief ) const
+{
+    int victim = -1;
+    int mostReady = 0;
+
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+    {
+        if( static_cast<int>( processor ) != thief &&
+            m_processors[ processor ].ReadyCount > mostReady )
+        {
+            victim = processor;
+            mostReady = m_processors[ processor ].ReadyCount;
+        }
+    }
+    return victim;
+}
+
+/**
+ * @brief      Whether an idle processor should steal from a victim.
+ * @details    "Balance" placement always steals. "Affinity" placement only
+ * steals when the victim's ready applications would wait longer, one quantum
+ * each, than a stolen application spends migrating and warming its cache.
+ *
+ * @param[in]  victim  The processor with the most ready applications.
+ *
+ * @return     True if the idle processor should steal, false otherwise.
+ */
+template <typename Policy>
+bool MultiProcessor<Policy>::worthStealing( int victim ) const
+{
+    if( m_config.placement != "Affinity" )
+        return true;
+
+    long long backlog = static_cast<long long>( 
+        m_processors[ victim ].ReadyCount ) * m_config.quantumTime;
+    return backlog > m_config.migrationCost + m_config.cacheWarmup;
+}
+
+/**
+ * @brief      The cycles an application spends warming its cache before its
+ * burst on a processor.
+ *
+ * @param[in]  app        The application about to run.
+ * @param[in]  processor  The processor it is about to run on.
+ *
+ * @return     The warm-up cycles, between 0 and the configured cache warm-up.
+ */
+template <typename Policy>
+long long MultiProcessor<Policy>::warmupCycles( const Application* app,
+    int processor ) const
+{
+    if( m_config.cacheWarmup <= 0 )
+        return 0;
+
+    // Only the processor the application last ran on holds a warm cache, and
+    // it halves in warmth every decay period since
+    double warmth = 0.0;
+    long long lastRun = m_lastRun[ app->getID() ];
+    if( lastRun >= 0 && m_lastProcessor[ app->getID() ] == processor )
+    {
+        double decay = std::max( m_config.cacheDecay, 1 );
+        warmth = std::exp2( -( m_processors[ processor ].Now - lastRun ) / 
+            decay );
+    }
+
+    return std::llround( m_config.cacheWarmup * ( 1.0 - warmth ) );
+}
+
+/**
+ * @brief      An application's burst has ended, it is either completed,
+ * returned to the ready queue, or blocked on I/O.
+ *
+ * @param[in]  processor  The processor the burst ran on.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::endBurst( int processor )
+{
+    Processor& cpu = m_processors[ processor ];
+    Application* app = cpu.Running;
+    cpu.Running = nullptr;
+    m_lastRun[ app->getID() ] = cpu.Now;
+    record( processor, RecordType::BurstEnd, app );
+
+    if( cpu.Result == BurstResult::Completed )
+    {
+        cpu.Completed++;
+    }
+    else if( cpu.Result == BurstResult::QuantumExpired )
+    {
+        cpu.Ready.onPreempt( app );
+        countReady( cpu, app, 1 );
+    }
+    else
+    {
+        // The request reaches its device at the end of the window
+        record( processor, RecordType::IOStart, app );
+        cpu.Requests.push_back( Request{ app->getDevice(),
+            Device::Request{ cpu.Now, app->startIO(), app->getAddress(),
+            app->isInput(), processor, app, 0, 0, false } } );
+    }
+
+    dispatch( processor );
+}
+
+/**
+ * @brief      An application's I/O has completed, it returns to the ready
+ * queue of the processor it last ran on.
+ *
+ * @param[in]  processor  The processor the application last ran on.
+ * @param[in]  event      The I/O completion event.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::completeIO( int processor, const Event& event )
+{
+    Processor& cpu = m_processors[ processor ];
+    Application* app = event.App;
+    record( processor, RecordType::IOEnd, app );
+
+    app->finishIO();
+    if( app->isFinished() )
+    {
+        cpu.Completed++;
+        return;
+    }
+
+    cpu.Ready.onUnblock( app );
+    countReady( cpu, app, 1 );
+    if( cpu.Running == nullptr )
+        dispatch( processor );
+}
+
+/**
+ * @brief      An application has arrived, it joins the ready queue of the
+ * processor it was dealt to.
+ *
+ * @param[in]  processor  The processor the application was dealt to.
+ * @param[in]  event      The arrival event.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::arrive( int processor, const Event& event )
+{
+    Processor& cpu = m_processors[ processor ];
+
+    cpu.Ready.enqueue( event.App );
+    countReady( cpu, event.App, 1 );
+    if( cpu.Running == nullptr )
+        dispatch( processor );
+}
+
+//
+// HELPER FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      The time of the earliest event, burst end, or device decision.
+ *
+ * @return     The time in ms, or -1 if nothing is pending.
+ */
+template <typename Policy>
+long long MultiProcessor<Policy>::earliestTime() const
+{
+    long long earliest = -1;
+    for( size_t device = 0; device < m_devices.size(); device++ )
+    {
+        long long decision = m_devices[ device ].nextDecision();
+        if( decision >= 0 && ( earliest < 0 || decision < earliest ) )
+            earliest = decision;
+    }
+
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+    {
+        const Processor& cpu = m_processors[ processor ];
+        if( !( cpu.Events.empty() ) &&
+            ( earliest < 0 || cpu.Events.top().Time < earliest ) )
+        {
+            earliest = cpu.Events.top().Time;
+        }
+        if( cpu.Running != nullptr &&
+            ( earliest < 0 || cpu.BurstEnd < earliest ) )
+        {
+            earliest = cpu.BurstEnd;
+        }
+    }
+    return earliest;
+}
+
+/**
+ * @brief      The first instant a processor could steal or be stolen from,
+ * assuming nothing interacts before it.
+ * @details    A busy processor stays busy until its burst ends and every
+ * ready application whose next burst takes at least one processor cycle has
+ * run, one cycle each at the least. An idle processor can only gain work from
+ * its own events. While any processor is idle, any other processor gaining a
+ * ready application from an event could be stolen from. When a request may
+ * complete at once, a busy processor could also make one as soon as its burst
+ * ends and any ready application that needs no processor cycle runs, or one
+ * that does has run, or an application returns from I/O.
+ *
+ * @return     The time in ms, or -1 if no processor can interact.
+ */
+template <typename Policy>
+long long MultiProcessor<Policy>::interaction() const
+{
+    long long first = -1;
+    long long growth = -1;
+    bool idle = false;
+
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+    {
+        const Processor& cpu = m_processors[ processor ];
+        long long event = cpu.Events.empty() ? -1 : cpu.Events.top().Time;
+        long long bound = event;
+
+        if( cpu.Running == nullptr )
+        {
+            idle = true;
+        }
+        else
+        {
+            long long bursts = cpu.ReadyProcessing;
+            if( cpu.Result == BurstResult::QuantumExpired &&
+                cpu.Running->isProcessing() )
+            {
+                bursts++;
+            }
+            bound = cpu.BurstEnd + bursts * m_config.processorCycle;
+            if( event >= 0 && ( growth < 0 || event < growth ) )
+                growth = event;
+
+            if( m_atOnce )
+            {
+                bool now = cpu.ReadyCount > cpu.ReadyProcessing ||
+                    ( cpu.Result == BurstResult::QuantumExpired &&
+                      !( cpu.Running->isProcessing() ) ) ||
+                    ( cpu.Result == BurstResult::IOCompleted &&
+                      completesAtOnce( cpu.Running ) );
+                bound = std::min( bound, cpu.BurstEnd +
+                    ( now ? 0 : m_config.processorCycle ) );
+                if( event >= 0 )
+                    bound = std::min( bound, std::max( event, cpu.BurstEnd ) );
+            }
+        }
+
+        if( bound >= 0 && ( first < 0 || bound < first ) )
+            first = bound;
+    }
+
+    if( idle && growth >= 0 && ( first < 0 || growth < first ) )
+        first = growth;
+    return first;
+}
+
+/**
+ * @brief      Whether the I/O an application is about to request may complete
+ * the instant it is made.
+ *
+ * @param[in]  app   The application, its current operation is I/O.
+ *
+ * @return     True if it may complete at once, false otherwise.
+ */
+template <typename Policy>
+bool MultiProcessor<Policy>::completesAtOnce( const Application* app ) const
+{
+    // Operations on an unknown device complete after their transfer alone
+    if( app->getDevice() < 0 )
+        return app->startIO() == 0;
+    return m_devices[ app->getDevice() ].completesAtOnce( app->startIO(),
+        app->isInput() );
+}
+
+/**
+ * @brief      The shortest time any I/O request of the workload can take from
+ * being made to its completion, which is how long a window may last.
+ * @details    A device's shortest request is its shortest operation plus its
+ * setup time, or a hit in its buffer cache.
+ *
+ * @param[in]  operations  Every operation of the simulation.
+ *
+ * @return     The time in ms, or -1 if the workload has no I/O.
+ */
+template <typename Policy>
+long long MultiProcessor<Policy>::shortestRequest( 
+    const OperationTable& operations ) const
+{
+    long long shortest = operations.shortestTime( -1 );
+    for( size_t device = 0; device < m_devices.size(); device++ )
+    {
+        long long transfer = operations.shortestTime( device );
+        if( transfer < 0 )
+            continue;
+
+        long long service = m_devices[ device ].shortestService( transfer );
+        if( shortest < 0 || service < shortest )
+            shortest = service;
+    }
+    return shortest;
+}
+
+/**
+ * @brief      Logs the busy time, utilization, steals, and migrations of every
+ * processor, then the utilization and queueing of every device.
+ */
+template <typename Policy>
+void MultiProcessor<Policy>::report() const
+{
+    // The simulation ends with the last event, not the last window
+    long long end = 0;
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+        end = std::max( end, m_processors[ processor ].Now );
+
+    logger << end / 1000.0f << " - OS: " << "END" << " simulation on "
+        << static_cast<int>( m_processors.size() ) << " processors\n";
+
+    for( size_t processor = 0; processor < m_processors.size(); processor++ )
+    {
+        const Processor& cpu = m_processors[ processor ];
+        float utilization = end > 0 ? 100.0f * cpu.BusyTime / end : 0.0f;
+
+        logger << "    Processor " << static_cast<int>( processor )
+            << ": busy " << static_cast<float>( cpu.BusyTime / 1000.0 )
+            << " s, utilization " << utilization << "%, bursts "
+            << static_cast<int>( cpu.Bursts ) << ", steals "
+            << static_cast<int>( cpu.Steals ) << ", migrations "
+            << static_cast<int>( cpu.Migrations ) << ", cache warm-up "
+            << static_cast<float>( cpu.WarmupTime / 1000.0 ) << " s\n";
+    }
+
+    for( size_t device = 0; device < m_devices.size(); device++ )
+        m_devices[ device ].report( end );
+}
+
+#endif  //  MULTIPROCESSOR_H
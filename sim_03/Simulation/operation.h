@@ -1,30 +1,43 @@
 #ifndef OPERATION_H
 #define OPERATION_H
 
-#include <iostream>
-#include <thread>
+#include <cstddef>
+#include <string>
 
-#include "Tools/config.h"
-#include "Tools/log.h"
-#include "Tools/timer.h"
+#include "Tools/copies.h"
 
+/**
+ * @brief      A meta-data operation as it is parsed, before it is stored in
+ * the simulation's OperationTable.
+ * @details    The name is not copied, it is the NameLength characters at Name
+ * of the text the operation was parsed or generated from, which must outlive
+ * the operation. The OperationTable keeps its own copy of every distinct name.
+ *
+ * Operations can be moved but not copied, so building a workload that copies
+ * one does not compile.
+ */
 class Operation
 {
 public:
-    Operation( Config config, int appID, std::string component, 
-        std::string name, int cycles);
-    void execute( int& cycles );
-    int getRemainingTime() const;
+    Operation( char component, const char* name, size_t nameLength,
+        int cycles );
+    Operation( Operation&& other ) = default;
+    Operation& operator=( Operation&& other ) = default;
+    Operation( const Operation& ) = delete;
+    Operation& operator=( const Operation& ) = delete;
+    bool isIO() const;
+    bool isNamed( const std::string& name ) const;
 
-    std::string Component;
-    std::string Name;
+    char Component;
+    const char* Name;
+    size_t NameLength;
     int RemainingCycles;
-private:
-    void runIO( int& cycles );
-    int calculateOperationTime( int& cycles );
+    unsigned long long Address = 0;
 
-    Config m_config;
-    int m_appID;
+#ifdef COUNT_COPIES
+private:
+    Copies::Counter m_copies;
+#endif
 };
 
-#endif  //  OPERATION_H
\ No newline at end of file
+#endif  //  OPERATION_H
@@ -0,0 +1,438 @@
+#include "operationtable.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for an empty table.
+ *
+ * @param[in]  config  The config for this simulation, which sets the cycle
+ * time of every kind of operation.
+ * @param      arena   The arena every column is allocated from, it must
+ * outlive this table.
+ */
+OperationTable::OperationTable( const Config& config, Arena& arena )
+    :   m_components( ArenaAllocator<char>( arena ) ),
+        m_kinds( ArenaAllocator<Kind>( arena ) ),
+        m_names( ArenaAllocator<unsigned short>( arena ) ),
+        m_cycles( ArenaAllocator<int>( arena ) ),
+        m_addresses( ArenaAllocator<unsigned long long>( arena ) ),
+        m_timeScale( config.timeScale )
+{
+    m_cycleTimes[ static_cast<int>( Kind::Processor ) ] = config.processorCycle;
+    m_cycleTimes[ static_cast<int>( Kind::HardDrive ) ] = config.hardDriveCycle;
+    m_cycleTimes[ static_cast<int>( Kind::Keyboard ) ] = config.keyboardCycle;
+    m_cycleTimes[ static_cast<int>( Kind::Monitor ) ] =
+        config.monitorDisplayCycle;
+    m_cycleTimes[ static_cast<int>( Kind::Printer ) ] = config.printerCycle;
+    m_cycleTimes[ static_cast<int>( Kind::Unknown ) ] = 0;
+}
+
+//
+// BUILDING ////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Reserves rows so that adding operations does not reallocate.
+ *
+ * @param[in]  operations  The number of operations expected.
+ */
+void OperationTable::reserve( size_t operations )
+{
+    m_components.reserve( operations );
+    m_kinds.reserve( operations );
+    m_names.reserve( operations );
+    m_cycles.reserve( operations );
+    m_addresses.reserve( operations );
+}
+
+/**
+ * @brief      Appends an operation as a new row.
+ * @details    A name past the first MaxNames - 1 distinct names is reported
+ * once and logged as "other", its kind still follows its own name.
+ *
+ * @param[in]  operation  The operation.
+ *
+ * @return     The index of its row.
+ */
+size_t OperationTable::add( const Operation& operation )
+{
+    // The key's buffer is reused, so only a new name allocates
+    m_nameKey.assign( operation.Name, operation.NameLength );
+    std::map<std::string, unsigned short>::iterator name =
+        m_nameIndex.find( m_nameKey );
+    if( name == m_nameIndex.end() && m_nameTable.size() < MaxNames - 1 )
+    {
+        name = m_nameIndex.insert( std::make_pair( m_nameKey,
+            static_cast<unsigned short>( m_nameTable.size() ) ) ).first;
+        m_nameTable.push_back( m_nameKey );
+    }
+    else if( name == m_nameIndex.end() )
+    {
+        if( m_nameTable.size() < MaxNames )
+        {
+            std::cout << "WARNING: More than " << MaxNames - 1 
+                << " distinct operation names, the rest are logged as "
+                << "\"other\"." << std::endl;
+            m_nameTable.push_back( "other" );
+        }
+        name = m_nameIndex.insert( std::make_pair( m_nameKey,
+            static_cast<unsigned short>( MaxNames - 1 ) ) ).first;
+    }
+
+    m_components.push_back( operation.Component );
+    m_kinds.push_back( kindOf( operation.Component, m_nameKey ) );
+    m_names.push_back( name->second );
+    m_cycles.push_back( operation.RemainingCycles );
+    m_addresses.push_back( operation.Address );
+
+    return m_cycles.size() - 1;
+}
+
+/**
+ * @brief      Gives a row more cycles, used to merge operations.
+ *
+ * @param[in]  index   The row.
+ * @param[in]  cycles  The cycles to add.
+ *
+ * @return     True if they were added, false if the row cannot hold that many
+ * cycles and is left as is.
+ */
+bool OperationTable::addCycles( size_t index, int cycles )
+{
+    if( cycles > std::numeric_limits<int>::max() - m_cycles[ index ] )
+        return false;
+
+    m_cycles[ index ] += cycles;
+    return true;
+}
+
+/**
+ * @brief      The number of rows.
+ *
+ * @return     The number of operations in the table.
+ */
+size_t OperationTable::size() const
+{
+    return m_cycles.size();
+}
+
+//
+// EXECUTION ///////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Execute an operation.
+ *
+ * @param[in]  index   The row of the operation.
+ * @param[in]  appID   The appID the operation belongs to.
+ * @param[in]  cycles  The amount of cycles to execute for.
+ * @param[out] cycles  The remaining amount of cycles, if any.
+ */
+void OperationTable::execute( size_t index, int appID, int& cycles )
+{
+    if( isIO( index ) )
+    {
+        std::thread ioThread( &OperationTable::runIO, this, index, appID,
+            std::ref( cycles ) );
+        ioThread.join();
+    }
+    else if( m_components[ index ] == 'P' )
+    {
+        logger << Timer::msDT() << " - Process " << appID << ": " << "START"
+            << " processing action\n";
+
+        std::this_thread::sleep_for( wallTime( consume( index, cycles ) ) );
+
+        logger << Timer::msDT() << " - Process " << appID << ": " << "END"
+            << " processing action\n";
+    }
+    else
+    {
+        logger << "END" << " - ERROR COMPONENT NAME\n";
+    }
+}
+
+/**
+ * @brief      Consumes an operation's cycles without waiting.
+ *
+ * @param[in]  index   The row of the operation.
+ * @param[in]  cycles  The amount of cycles to consume.
+ * @param[out] cycles  The remaining amount of cycles, if any.
+ *
+ * @return     The time in ms the consumed cycles represent.
+ */
+int OperationTable::consume( size_t index, int& cycles )
+{
+    int cycleTime = m_cycleTimes[ static_cast<int>( m_kinds[ index ] ) ];
+    int& remainingCycles = m_cycles[ index ];
+
+    // Update Remaining Time
+    if( remainingCycles - cycles > 0 )
+    {
+        int runningTime = cycles * cycleTime;
+        remainingCycles -= cycles;
+        cycles = 0;
+        return runningTime;
+    }
+    // Some cycles have not been consumed
+    else
+    {
+        int runningTime = remainingCycles * cycleTime;
+        cycles -= remainingCycles;
+        remainingCycles = 0;
+        return runningTime;
+    }
+}
+
+//
+// ACCESSORS ///////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Get the remaining time in ms for an operation.
+ *
+ * @param[in]  index  The row of the operation.
+ *
+ * @return     The remaining time the operation has in ms.
+ */
+long long OperationTable::getRemainingTime( size_t index ) const
+{
+    return static_cast<long long>( m_cycles[ index ] ) *
+        m_cycleTimes[ static_cast<int>( m_kinds[ index ] ) ];
+}
+
+/**
+ * @brief      Get the remaining time in ms for a range of operations, such as
+ * every operation an application has left.
+ * @details    Built with AVX2 ("make SIMD=avx2") eight rows are handled at
+ * once: their kinds are widened to indices, the cycle times gathered, and the
+ * cycles and cycle times widened to 64 bits, four rows to a register, so the
+ * products are summed lane by lane without overflow. The rows that do not
+ * fill eight lanes, and every row of a build without AVX2, are summed one at
+ * a time.
+ *
+ * @param[in]  first  The first row.
+ * @param[in]  last   The row after the last.
+ *
+ * @return     The total remaining time of the rows in ms.
+ */
+long long OperationTable::getRemainingTime( size_t first,
+    size_t last ) const
+{
+    long long remainingTime = 0;
+    size_t index = first;
+
+#ifdef __AVX2__
+    __m256i sums = _mm256_setzero_si256();
+    for( ; index + 8 <= last; index += 8 )
+    {
+        __m256i kinds = _mm256_cvtepu8_epi32( _mm_loadl_epi64(
+            reinterpret_cast<const __m128i*>( &m_kinds[ index ] ) ) );
+        __m256i cycleTimes = _mm256_i32gather_epi32( m_cycleTimes, kinds, 
+            sizeof( int ) );
+        __m256i cycles = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>( &m_cycles[ index ] ) );
+
+        sums = _mm256_add_epi64( sums, _mm256_mul_epi32(
+            _mm256_cvtepi32_epi64( _mm256_castsi256_si128( cycles ) ),
+            _mm256_cvtepi32_epi64( _mm256_castsi256_si128( cycleTimes ) ) ) );
+        sums = _mm256_add_epi64( sums, _mm256_mul_epi32(
+            _mm256_cvtepi32_epi64( _mm256_extracti128_si256( cycles, 1 ) ),
+            _mm256_cvtepi32_epi64( _mm256_extracti128_si256( 
+            cycleTimes, 1 ) ) ) );
+    }
+
+    long long lanes[ 4 ];
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( lanes ), sums );
+    for( int lane = 0; lane < 4; lane++ )
+        remainingTime += lanes[ lane ];
+#endif
+
+    for( ; index < last; index++ )
+        remainingTime += getRemainingTime( index );
+
+    return remainingTime;
+}
+
+/**
+ * @brief      Get the remaining cycles of an operation.
+ *
+ * @param[in]  index  The row of the operation.
+ *
+ * @return     The cycles the operation has left.
+ */
+int OperationTable::getRemainingCycles( size_t index ) const
+{
+    return m_cycles[ index ];
+}
+
+/**
+ * @brief      Whether an operation is an input "I" or output "O" operation.
+ *
+ * @param[in]  index  The row of the operation.
+ *
+ * @return     True if the operation uses an I/O device, false otherwise.
+ */
+bool OperationTable::isIO( size_t index ) const
+{
+    return m_components[ index ] == 'I' || m_components[ index ] == 'O';
+}
+
+/**
+ * @brief      Whether an operation is an input "I" operation.
+ *
+ * @param[in]  index  The row of the operation.
+ *
+ * @return     True if the operation reads from its device, false otherwise.
+ */
+bool OperationTable::isInput( size_t index ) const
+{
+    return m_components[ index ] == 'I';
+}
+
+/**
+ * @brief      The device an operation uses.
+ *
+ * @param[in]  index  The row of the operation.
+ *
+ * @return     The index of the device as in Device::index(), or -1 if the
+ * operation uses no known device.
+ */
+int OperationTable::getDevice( size_t index ) const
+{
+    if( !( isIO( index ) ) || m_kinds[ index ] == Kind::Unknown )
+        return -1;
+    return static_cast<int>( m_kinds[ index ] ) - 1;
+}
+
+/**
+ * @brief      The name of an operation, such as "hard drive".
+ *
+ * @param[in]  index  The row of the operation.
+ *
+ * @return     The name.
+ */
+const std::string& OperationTable::getName( size_t index ) const
+{
+    return m_nameTable[ m_names[ index ] ];
+}
+
+/**
+ * @brief      The device address of an operation.
+ *
+ * @param[in]  index  The row of the operation.
+ *
+ * @return     The address.
+ */
+unsigned long long OperationTable::getAddress( size_t index ) const
+{
+    return m_addresses[ index ];
+}
+
+/**
+ * @brief      The shortest remaining time of any input / output operation on a
+ * device.
+ *
+ * @param[in]  device  The index of the device as in Device::index(), or -1
+ * for operations on an unknown device.
+ *
+ * @return     The shortest time in ms, or -1 if no operation uses the device.
+ */
+long long OperationTable::shortestTime( int device ) const
+{
+    long long shortest = -1;
+    for( size_t index = 0; index < m_cycles.size(); index++ )
+    {
+        if( isIO( index ) && getDevice( index ) == device )
+        {
+            long long time = getRemainingTime( index );
+            if( shortest < 0 || time < shortest )
+                shortest = time;
+        }
+    }
+    return shortest;
+}
+
+/**
+ * @brief      How long a simulated time takes in real time, which the config's
+ * time scale shortens or stretches.
+ *
+ * @param[in]  time  The simulated time in ms.
+ *
+ * @return     The real time to wait.
+ */
+std::chrono::microseconds OperationTable::wallTime( long long time ) const
+{
+    return std::chrono::microseconds( static_cast<long long>( 
+        time * 1000.0 * m_timeScale ) );
+}
+
+/**
+ * @brief      The bytes each row occupies across every column.
+ *
+ * @return     The size of one operation in bytes.
+ */
+size_t OperationTable::bytesPerOperation()
+{
+    return sizeof( char ) + sizeof( Kind ) + sizeof( unsigned short ) +
+        sizeof( int ) + sizeof( unsigned long long );
+}
+
+//
+// HELPER FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Helper function to select the kind of cycle an operation takes.
+ *
+ * @param[in]  component  The component letter 'I' / 'O' / 'P'.
+ * @param[in]  name       The name of the operation.
+ *
+ * @return     The kind, Unknown if no cycle time applies.
+ */
+OperationTable::Kind OperationTable::kindOf( char component,
+    const std::string& name )
+{
+    // Select the process' cycle time
+    if( component == 'P' )
+    {
+        return Kind::Processor;
+    }
+    // Select the input's / output's cycle time
+    else if( component == 'I' || component == 'O' )
+    {
+        if( name == "hard drive" )
+            return Kind::HardDrive;
+        else if ( name == "keyboard" )
+            return Kind::Keyboard;
+        else if ( name == "monitor" )
+            return Kind::Monitor;
+        else if ( name == "printer" )
+            return Kind::Printer;
+    }
+
+    return Kind::Unknown;
+}
+
+/**
+ * @brief      Executes an input / output operation "I" / "O" with a defined
+ * cycle amount.
+ *
+ * @param[in]  index   The row of the operation.
+ * @param[in]  appID   The appID the operation belongs to.
+ * @param[in]  cycles  The number of cycles to wait for.
+ */
+void OperationTable::runIO( size_t index, int appID, int& cycles )
+{
+    const char* direction = isInput( index ) ? " input\n" : " output\n";
+
+    logger << Timer::msDT() << " - Process " << appID << ": " << "START"
+        << " " << getName( index ) << direction;
+
+    std::this_thread::sleep_for( wallTime( consume( index, cycles ) ) );
+
+    logger << Timer::msDT() << " - Process " << appID << ": " << "END"
+        << " " << getName( index ) << direction;
+}
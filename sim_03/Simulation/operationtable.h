@@ -0,0 +1,99 @@
+#ifndef OPERATIONTABLE_H
+#define OPERATIONTABLE_H
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "Tools/arena.h"
+#include "Tools/config.h"
+#include "Tools/log.h"
+#include "Tools/timer.h"
+
+#include "operation.h"
+
+/**
+ * @brief      Every operation of the simulation, stored column by column.
+ * @details    Each application owns a contiguous range of rows. A row is the
+ * operation's component letter, the kind of cycle it takes, its name as an
+ * index into a table of the distinct names, its remaining cycles, and its
+ * device address, 16 bytes in all. The cycle time of every kind is kept once
+ * for the whole table, so a remaining time is a single multiply, and the
+ * remaining time of a range of rows is a dot product of the cycle column with
+ * the cycle times its kinds select.
+ *
+ * Every column is allocated from the simulation's arena.
+ */
+class OperationTable
+{
+public:
+    /**
+     * @brief      What one cycle of an operation costs, in the order of
+     * Device::index() after the processor.
+     */
+    enum class Kind : unsigned char
+    {
+        Processor,
+        HardDrive,
+        Keyboard,
+        Monitor,
+        Printer,
+        Unknown
+    };
+
+    static const int Kinds = 6;
+
+    // Names are stored as 16 bit indices, the last is shared by every name
+    // past it
+    static const size_t MaxNames =
+        std::numeric_limits<unsigned short>::max() + 1;
+
+    OperationTable( const Config& config, Arena& arena );
+
+    void reserve( size_t operations );
+    size_t add( const Operation& operation );
+    bool addCycles( size_t index, int cycles );
+    size_t size() const;
+
+    void execute( size_t index, int appID, int& cycles );
+    int consume( size_t index, int& cycles );
+    long long getRemainingTime( size_t index ) const;
+    long long getRemainingTime( size_t first, size_t last ) const;
+    int getRemainingCycles( size_t index ) const;
+    bool isIO( size_t index ) const;
+    bool isInput( size_t index ) const;
+    int getDevice( size_t index ) const;
+    const std::string& getName( size_t index ) const;
+    unsigned long long getAddress( size_t index ) const;
+    long long shortestTime( int device ) const;
+    std::chrono::microseconds wallTime( long long time ) const;
+
+    static size_t bytesPerOperation();
+
+private:
+    static Kind kindOf( char component, const std::string& name );
+    void runIO( size_t index, int appID, int& cycles );
+
+    int m_cycleTimes[ Kinds ];
+    std::vector< char, ArenaAllocator<char> > m_components;
+    std::vector< Kind, ArenaAllocator<Kind> > m_kinds;
+    std::vector< unsigned short, ArenaAllocator<unsigned short> > m_names;
+    std::vector< int, ArenaAllocator<int> > m_cycles;
+    std::vector< unsigned long long, ArenaAllocator<unsigned long long> >
+        m_addresses;
+    float m_timeScale;
+
+    std::vector<std::string> m_nameTable;
+    std::map<std::string, unsigned short> m_nameIndex;
+    std::string m_nameKey;
+};
+
+#endif  //  OPERATIONTABLE_H
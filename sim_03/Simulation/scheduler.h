@@ -0,0 +1,791 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <vector>
+
+#include "Tools/config.h"
+#include "Tools/pool.h"
+#include "Tools/random.h"
+
+#include "application.h"
+
+/**
+ * @brief      Scheduling policies that are given to Simulator::run as a
+ * template parameter.
+ * @details    A policy owns the ready queue and never sees a blocked or
+ * completed application. Every policy provides:
+ *
+ *     Policy( const Config& config );
+ *     bool empty() const;
+ *     void enqueue( Application* app );    // A new application arrived
+ *     Application* pickNext();             // Remove the next application
+ *     int timeSlice( const Application* app ) const;
+ *     void onPreempt( Application* app );  // Its quantum expired
+ *     void onUnblock( Application* app );  // Its I/O has completed
+ *     Application* steal( long long& lag );
+ *     void migrate( Application* app, long long lag );
+ *
+ * steal() removes the application that would run last, for another
+ * processor's policy to migrate() it. The lag carries its place in the queue,
+ * such as its level or how far its virtual runtime or pass is ahead of the
+ * queue's own, so that it is rebased to the new queue rather than treated as
+ * a new arrival.
+ * To add a policy, write a class with these members and register its
+ * scheduling code in Simulator::Schedulers.
+ */
+
+//
+// ROUND ROBIN /////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Round Robin (RR), every application is given a quantum in the
+ * order that it became ready.
+ */
+class RoundRobinPolicy
+{
+public:
+    RoundRobinPolicy( const Config& config )
+        :   m_quantumTime( config.quantumTime )
+    {
+    }
+
+    bool empty() const
+    {
+        return m_ready.empty();
+    }
+
+    void enqueue( Application* app )
+    {
+        m_ready.push_back( app );
+    }
+
+    Application* pickNext()
+    {
+        Application* app = m_ready.front();
+        m_ready.pop_front();
+        return app;
+    }
+
+    int timeSlice( const Application* ) const
+    {
+        return m_quantumTime;
+    }
+
+    void onPreempt( Application* app )
+    {
+        m_ready.push_back( app );
+    }
+
+    void onUnblock( Application* app )
+    {
+        m_ready.push_back( app );
+    }
+
+    Application* steal( long long& lag )
+    {
+        Application* app = m_ready.back();
+        m_ready.pop_back();
+        lag = 0;
+        return app;
+    }
+
+    void migrate( Application* app, long long )
+    {
+        m_ready.push_back( app );
+    }
+
+private:
+    int m_quantumTime;
+    std::deque< Application*, PoolAllocator<Application*> > m_ready;
+};
+
+//
+// FIRST IN FIRST OUT - PRE-EMPTION ////////////////////////////////////////////
+//
+
+/**
+ * @brief      First In First Out with pre-emption (FIFO-P), the ready
+ * application that arrived first is always given the processor.
+ * @details    Ready applications are kept in a std::set ordered by arrival, so
+ * the one that arrived last can be stolen from the other end.
+ */
+class FirstInFirstOutPreEmptionPolicy
+{
+public:
+    FirstInFirstOutPreEmptionPolicy( const Config& config )
+        :   m_quantumTime( config.quantumTime )
+    {
+    }
+
+    bool empty() const
+    {
+        return m_ready.empty();
+    }
+
+    void enqueue( Application* app )
+    {
+        m_ready.insert( app );
+    }
+
+    Application* pickNext()
+    {
+        Application* app = *m_ready.begin();
+        m_ready.erase( m_ready.begin() );
+        return app;
+    }
+
+    int timeSlice( const Application* ) const
+    {
+        return m_quantumTime;
+    }
+
+    void onPreempt( Application* app )
+    {
+        m_ready.insert( app );
+    }
+
+    void onUnblock( Application* app )
+    {
+        m_ready.insert( app );
+    }
+
+    Application* steal( long long& lag )
+    {
+        Ready::iterator last = --m_ready.end();
+        Application* app = *last;
+        m_ready.erase( last );
+        lag = 0;
+        return app;
+    }
+
+    void migrate( Application* app, long long )
+    {
+        m_ready.insert( app );
+    }
+
+private:
+    struct ArrivedEarlier
+    {
+        bool operator()( const Application* app1,
+            const Application* app2 ) const
+        {
+            return app1->getID() < app2->getID();
+        }
+    };
+
+    typedef std::set< Application*, ArrivedEarlier,
+        PoolAllocator<Application*> > Ready;
+
+    int m_quantumTime;
+    Ready m_ready;
+};
+
+//
+// SHORTEST REMAINING TIME FIRST - PRE-EMPTION /////////////////////////////////
+//
+
+/**
+ * @brief      Shortest Remaining Time First with pre-emption (SRTF-P), the
+ * ready application with the least ApplicationTime is given the processor.
+ * @details    An application's ApplicationTime only changes while it runs, so
+ * the std::set stays ordered while applications wait in it, and the one with
+ * the most time left can be stolen from the other end. Ties are broken by
+ * the order applications became ready, as the stable sort of the original
+ * ready list did.
+ */
+class ShortestRemainingTimeFirstPreEmptionPolicy
+{
+public:
+    ShortestRemainingTimeFirstPreEmptionPolicy( const Config& config )
+        :   m_quantumTime( config.quantumTime ),
+            m_sequence( 0 )
+    {
+    }
+
+    bool empty() const
+    {
+        return m_ready.empty();
+    }
+
+    void enqueue( Application* app )
+    {
+        push( app );
+    }
+
+    Application* pickNext()
+    {
+        Application* app = m_ready.begin()->App;
+        m_ready.erase( m_ready.begin() );
+        return app;
+    }
+
+    int timeSlice( const Application* ) const
+    {
+        return m_quantumTime;
+    }
+
+    void onPreempt( Application* app )
+    {
+        push( app );
+    }
+
+    void onUnblock( Application* app )
+    {
+        push( app );
+    }
+
+    Application* steal( long long& lag )
+    {
+        Ready::iterator last = --m_ready.end();
+        Application* app = last->App;
+        m_ready.erase( last );
+        lag = 0;
+        return app;
+    }
+
+    void migrate( Application* app, long long )
+    {
+        // Its remaining time goes with it, it becomes ready here from now
+        push( app );
+    }
+
+private:
+    struct Entry
+    {
+        long long RemainingTime;
+        long long Sequence;
+        Application* App;
+
+        bool operator<( const Entry& other ) const
+        {
+            if( RemainingTime != other.RemainingTime )
+                return RemainingTime < other.RemainingTime;
+            return Sequence < other.Sequence;
+        }
+    };
+
+    typedef std::set< Entry, std::less<Entry>, PoolAllocator<Entry> > Ready;
+
+    void push( Application* app )
+    {
+        m_ready.insert( Entry{ app->ApplicationTime, m_sequence++, app } );
+    }
+
+    int m_quantumTime;
+    long long m_sequence;
+    Ready m_ready;
+};
+
+//
+// COMPLETELY FAIR SCHEDULER ///////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Completely Fair Scheduler (CFS), the ready application that has
+ * received the least virtual runtime is given the processor.
+ * @details    Ready applications are kept in a red-black tree (std::set)
+ * ordered by virtual runtime, so selecting the leftmost application and
+ * re-inserting it are O(log n). The time slice divides the target latency
+ * between every runnable application but never falls below the minimum
+ * granularity, the quantum time is not used.
+ */
+class CompletelyFairSchedulerPolicy
+{
+public:
+    CompletelyFairSchedulerPolicy( const Config& config )
+        :   m_targetLatency( config.targetLatency ),
+            m_minimumGranularity( std::max( config.minimumGranularity, 1 ) ),
+            m_minimumVirtualRuntime( 0 )
+    {
+    }
+
+    bool empty() const
+    {
+        return m_timeline.empty();
+    }
+
+    void enqueue( Application* app )
+    {
+        // New applications start level with the least served application
+        insert( app, m_minimumVirtualRuntime );
+    }
+
+    Application* pickNext()
+    {
+        Timeline::iterator leftmost = m_timeline.begin();
+        Application* app = leftmost->App;
+        m_minimumVirtualRuntime = std::max( m_minimumVirtualRuntime, 
+            leftmost->VirtualRuntime );
+        m_timeline.erase( leftmost );
+        return app;
+    }
+
+    int timeSlice( const Application* ) const
+    {
+        // The application about to run has already left the timeline
+        int runnable = static_cast<int>( m_timeline.size() ) + 1;
+        return std::max( m_minimumGranularity, m_targetLatency / runnable );
+    }
+
+    void onPreempt( Application* app )
+    {
+        insert( app, virtualRuntime( app ) + app->BurstCycles );
+    }
+
+    void onUnblock( Application* app )
+    {
+        // An application returning from I/O may not bank more than half of a
+        // target latency ahead of the least served application
+        long long runtime = virtualRuntime( app ) + app->BurstCycles;
+        insert( app, std::max( runtime, 
+            m_minimumVirtualRuntime - m_targetLatency / 2 ) );
+    }
+
+    Application* steal( long long& lag )
+    {
+        Timeline::iterator rightmost = --m_timeline.end();
+        Application* app = rightmost->App;
+        lag = rightmost->VirtualRuntime - m_minimumVirtualRuntime;
+        m_timeline.erase( rightmost );
+        return app;
+    }
+
+    void migrate( Application* app, long long lag )
+    {
+        // Keeps how far it was from the least served application it left
+        insert( app, m_minimumVirtualRuntime + lag );
+    }
+
+private:
+    struct Entry
+    {
+        long long VirtualRuntime;
+        Application* App;
+
+        bool operator<( const Entry& other ) const
+        {
+            if( VirtualRuntime != other.VirtualRuntime )
+                return VirtualRuntime < other.VirtualRuntime;
+            return App->getID() < other.App->getID();
+        }
+    };
+
+    typedef std::set< Entry, std::less<Entry>, PoolAllocator<Entry> >
+        Timeline;
+
+    long long virtualRuntime( const Application* app ) const
+    {
+        return m_virtualRuntimes[ app->getID() ];
+    }
+
+    void insert( Application* app, long long runtime )
+    {
+        // Application IDs are dense, so they index the runtime table directly
+        if( app->getID() >= static_cast<int>( m_virtualRuntimes.size() ) )
+            m_virtualRuntimes.resize( app->getID() + 1, 0 );
+
+        m_virtualRuntimes[ app->getID() ] = runtime;
+        m_timeline.insert( Entry{ runtime, app } );
+    }
+
+    int m_targetLatency;
+    int m_minimumGranularity;
+    long long m_minimumVirtualRuntime;
+    std::vector<long long> m_virtualRuntimes;
+    Timeline m_timeline;
+};
+
+//
+// MULTI-LEVEL FEEDBACK QUEUE //////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Multi-Level Feedback Queue (MLFQ), the first application of the
+ * highest non-empty priority level is given the processor.
+ * @details    Every level is a FIFO queue with its own quantum. Applications
+ * that use their whole quantum are demoted a level, applications that block
+ * on I/O are promoted a level, and every boost period all applications are
+ * returned to the highest level. A bitmap of non-empty levels makes selection
+ * O(1) regardless of the number of applications.
+ */
+class MultiLevelFeedbackQueuePolicy
+{
+public:
+    MultiLevelFeedbackQueuePolicy( const Config& config )
+        :   m_quanta( config.feedbackQuanta ),
+            m_boostPeriod( config.feedbackBoostPeriod ),
+            m_cyclesSinceBoost( 0 ),
+            m_nonEmptyLevels( 0 )
+    {
+        // The bitmap holds one bit per level
+        if( m_quanta.empty() )
+            m_quanta.push_back( config.quantumTime );
+        if( m_quanta.size() > MaximumLevels )
+            m_quanta.resize( MaximumLevels );
+
+        m_levels.resize( m_quanta.size() );
+    }
+
+    bool empty() const
+    {
+        return m_nonEmptyLevels == 0;
+    }
+
+    void enqueue( Application* app )
+    {
+        push( app, 0 );
+    }
+
+    Application* pickNext()
+    {
+        // The lowest set bit is the highest priority non-empty level
+        int level = __builtin_ctzll( m_nonEmptyLevels );
+        Application* app = m_levels[ level ].front();
+        m_levels[ level ].pop_front();
+
+        if( m_levels[ level ].empty() )
+            m_nonEmptyLevels &= ~( uint64_t( 1 ) << level );
+
+        return app;
+    }
+
+    int timeSlice( const Application* app ) const
+    {
+        return m_quanta[ m_priorities[ app->getID() ] ];
+    }
+
+    void onPreempt( Application* app )
+    {
+        int level = std::min( m_priorities[ app->getID() ] + 1,
+            static_cast<int>( m_levels.size() ) - 1 );
+        push( app, level );
+        account( app );
+    }
+
+    void onUnblock( Application* app )
+    {
+        int level = std::max( m_priorities[ app->getID() ] - 1, 0 );
+        push( app, level );
+        account( app );
+    }
+
+    Application* steal( long long& lag )
+    {
+        // The highest set bit is the lowest priority non-empty level
+        int level = 63 - __builtin_clzll( m_nonEmptyLevels );
+        Application* app = m_levels[ level ].back();
+        m_levels[ level ].pop_back();
+
+        if( m_levels[ level ].empty() )
+            m_nonEmptyLevels &= ~( uint64_t( 1 ) << level );
+
+        lag = level;
+        return app;
+    }
+
+    void migrate( Application* app, long long lag )
+    {
+        push( app, std::min( static_cast<int>( lag ),
+            static_cast<int>( m_levels.size() ) - 1 ) );
+    }
+
+private:
+    typedef std::deque< Application*, PoolAllocator<Application*> > Level;
+
+    static const size_t MaximumLevels = 64;
+
+    void push( Application* app, int level )
+    {
+        // Application IDs are dense, so they index the priority table directly
+        if( app->getID() >= static_cast<int>( m_priorities.size() ) )
+            m_priorities.resize( app->getID() + 1, 0 );
+
+        m_priorities[ app->getID() ] = level;
+        m_levels[ level ].push_back( app );
+        m_nonEmptyLevels |= uint64_t( 1 ) << level;
+    }
+
+    void account( const Application* app )
+    {
+        m_cyclesSinceBoost += app->BurstCycles;
+        if( m_boostPeriod > 0 && m_cyclesSinceBoost >= m_boostPeriod )
+            boost();
+    }
+
+    void boost()
+    {
+        // Move every lower level to the back of the highest level in order
+        for( size_t level = 1; level < m_levels.size(); level++ )
+        {
+            for( Level::iterator iter = m_levels[ level ].begin();
+                 iter != m_levels[ level ].end(); ++iter )
+            {
+                m_priorities[ ( *iter )->getID() ] = 0;
+                m_levels[ 0 ].push_back( *iter );
+            }
+            m_levels[ level ].clear();
+        }
+
+        m_nonEmptyLevels = m_levels[ 0 ].empty() ? 0 : 1;
+        m_cyclesSinceBoost = 0;
+    }
+
+    std::vector<int> m_quanta;
+    int m_boostPeriod;
+    int m_cyclesSinceBoost;
+    uint64_t m_nonEmptyLevels;
+    std::vector<int> m_priorities;
+    std::vector<Level> m_levels;
+};
+
+//
+// LOTTERY /////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Lottery scheduling, every quantum a ticket is drawn and the
+ * ready application holding it is given the processor.
+ * @details    Ready applications' tickets are kept in a Fenwick tree indexed
+ * by application ID, so both a draw and a ticket update are O(log n). Draws
+ * come from a generator seeded by the config, so runs are reproducible.
+ */
+class LotteryPolicy
+{
+public:
+    LotteryPolicy( const Config& config )
+        :   m_quantumTime( config.quantumTime ),
+            m_random( config.randomSeed ),
+            m_totalTickets( 0 ),
+            m_readyCount( 0 )
+    {
+    }
+
+    bool empty() const
+    {
+        return m_readyCount == 0;
+    }
+
+    void enqueue( Application* app )
+    {
+        int id = app->getID();
+        if( id >= static_cast<int>( m_tree.size() ) )
+            grow( id );
+
+        // An application without tickets still needs a chance to finish
+        long long tickets = std::max( app->Tickets, 1 );
+        m_apps[ id ] = app;
+        m_tickets[ id ] = tickets;
+        add( id, tickets );
+        m_readyCount++;
+    }
+
+    Application* pickNext()
+    {
+        int id = find( m_random.below( m_totalTickets ) );
+        add( id, -m_tickets[ id ] );
+        m_tickets[ id ] = 0;
+        m_readyCount--;
+        return m_apps[ id ];
+    }
+
+    int timeSlice( const Application* ) const
+    {
+        return m_quantumTime;
+    }
+
+    void onPreempt( Application* app )
+    {
+        enqueue( app );
+    }
+
+    void onUnblock( Application* app )
+    {
+        enqueue( app );
+    }
+
+    Application* steal( long long& lag )
+    {
+        // The last ticket belongs to the ready application that arrived last
+        int id = find( m_totalTickets - 1 );
+        add( id, -m_tickets[ id ] );
+        m_tickets[ id ] = 0;
+        m_readyCount--;
+        lag = 0;
+        return m_apps[ id ];
+    }
+
+    void migrate( Application* app, long long )
+    {
+        // Its tickets are its own, so it draws here as it did there
+        enqueue( app );
+    }
+
+private:
+    void add( int id, long long tickets )
+    {
+        m_totalTickets += tickets;
+        for( size_t index = id; index < m_tree.size(); index += index & -index )
+            m_tree[ index ] += tickets;
+    }
+
+    int find( long long ticket ) const
+    {
+        // Descend to the first ID whose running ticket total exceeds the draw
+        size_t index = 0;
+        for( size_t step = m_tree.size() / 2; step > 0; step /= 2 )
+        {
+            if( index + step < m_tree.size() &&
+                m_tree[ index + step ] <= ticket )
+            {
+                index += step;
+                ticket -= m_tree[ index ];
+            }
+        }
+        return static_cast<int>( index + 1 );
+    }
+
+    void grow( int id )
+    {
+        // The tree is rebuilt at the next power of two, so growth is amortized
+        size_t size = 2;
+        while( size <= static_cast<size_t>( id ) )
+            size *= 2;
+
+        m_apps.resize( size, nullptr );
+        m_tickets.resize( size, 0 );
+        m_tree.assign( m_tickets.begin(), m_tickets.end() );
+        for( size_t index = 1; index < size; index++ )
+        {
+            size_t parent = index + ( index & -index );
+            if( parent < size )
+                m_tree[ parent ] += m_tree[ index ];
+        }
+    }
+
+    int m_quantumTime;
+    Random m_random;
+    long long m_totalTickets;
+    int m_readyCount;
+    std::vector<Application*> m_apps;
+    std::vector<long long> m_tickets;
+    std::vector<long long> m_tree;
+};
+
+//
+// STRIDE //////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Stride scheduling, the deterministic counterpart of lottery
+ * scheduling. The ready application with the lowest pass value is given the
+ * processor.
+ * @details    An application's pass advances by its stride, which is inversely
+ * proportional to its tickets, for every cycle it runs. Pass values are kept
+ * in a std::set, so selection is O(log n) and the application with the
+ * highest pass can be stolen from the other end.
+ */
+class StridePolicy
+{
+public:
+    StridePolicy( const Config& config )
+        :   m_quantumTime( config.quantumTime ),
+            m_globalPass( 0 )
+    {
+    }
+
+    bool empty() const
+    {
+        return m_ready.empty();
+    }
+
+    void enqueue( Application* app )
+    {
+        // New applications join at the pass of the last selection
+        push( app, m_globalPass );
+    }
+
+    Application* pickNext()
+    {
+        Entry entry = *m_ready.begin();
+        m_ready.erase( m_ready.begin() );
+        m_globalPass = entry.Pass;
+        return entry.App;
+    }
+
+    int timeSlice( const Application* ) const
+    {
+        return m_quantumTime;
+    }
+
+    void onPreempt( Application* app )
+    {
+        push( app, advance( app ) );
+    }
+
+    void onUnblock( Application* app )
+    {
+        // Time spent blocked is not credited to the application
+        push( app, std::max( advance( app ), m_globalPass ) );
+    }
+
+    Application* steal( long long& lag )
+    {
+        Ready::iterator last = --m_ready.end();
+        Application* app = last->App;
+        lag = last->Pass - m_globalPass;
+        m_ready.erase( last );
+        return app;
+    }
+
+    void migrate( Application* app, long long lag )
+    {
+        // Keeps how far its pass was ahead of the last selection it left
+        push( app, m_globalPass + lag );
+    }
+
+private:
+    static const long long BigStride = 1 << 20;
+
+    struct Entry
+    {
+        long long Pass;
+        Application* App;
+
+        bool operator<( const Entry& other ) const
+        {
+            if( Pass != other.Pass )
+                return Pass < other.Pass;
+            return App->getID() < other.App->getID();
+        }
+    };
+
+    typedef std::set< Entry, std::less<Entry>, PoolAllocator<Entry> > Ready;
+
+    long long advance( const Application* app ) const
+    {
+        long long stride = BigStride / std::max( app->Tickets, 1 );
+        return m_passes[ app->getID() ] + stride * app->BurstCycles;
+    }
+
+    void push( Application* app, long long pass )
+    {
+        // Application IDs are dense, so they index the pass table directly
+        if( app->getID() >= static_cast<int>( m_passes.size() ) )
+            m_passes.resize( app->getID() + 1, 0 );
+
+        m_passes[ app->getID() ] = pass;
+        m_ready.insert( Entry{ pass, app } );
+    }
+
+    int m_quantumTime;
+    long long m_globalPass;
+    std::vector<long long> m_passes;
+    Ready m_ready;
+};
+
+#endif  //  SCHEDULER_H
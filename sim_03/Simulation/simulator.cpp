@@ -4,10 +4,13 @@
  * @brief      Default constructor to build a simulator.
  *
  * @param[in]  config      The configuration associated with this Simulator.
- * @param[in]  operations  The full list of oeprations to simulate.
+ * @param[in]  operations  The full list of oeprations to simulate, which the
+ * simulator takes ownership of and frees once the workload is built.
  */
-Simulator::Simulator( Config config, std::list<std::string> operations )
-    :   m_config( config )
+Simulator::Simulator( const Config& config, 
+    std::list<std::string> operations )
+    :   m_config( config ), m_operations( config, m_arena ),
+        m_applications( ArenaAllocator<Application>( m_arena ) )
 {
     logger << Timer::msDT() << " - OS: " << "START" << " process preparation\n";
     
@@ -20,6 +23,25 @@ Simulator::Simulator( Config config, std::list<std::string> operations )
     logger << Timer::msDT() << " - OS: " << "END" << " process preparation\n";
 }
 
+/**
+ * @brief      Constructor to build a simulator straight from a generated
+ * workload, without writing or parsing its meta-data.
+ * @details    The simulation is the same as that of the file the generator
+ * would write with the same options.
+ *
+ * @param[in]  config    The configuration associated with this Simulator.
+ * @param[in]  workload  The options of the workload to generate, its profile
+ * and bursts must be known, see Generator.
+ */
+Simulator::Simulator( const Config& config, const GeneratorOptions& workload )
+    :   m_config( config ), m_operations( config, m_arena ),
+        m_applications( ArenaAllocator<Application>( m_arena ) )
+{
+    logger << Timer::msDT() << " - OS: " << "START" << " process preparation\n";
+    buildGenerated( workload );
+    logger << Timer::msDT() << " - OS: " << "END" << " process preparation\n";
+}
+
 //
 // MAIN SIMULATOR LOOP /////////////////////////////////////////////////////////
 //
@@ -27,24 +49,202 @@ Simulator::Simulator( Config config, std::list<std::string> operations )
 /**
  * @brief      Starts the simulation by executing each application with the
  * config's scheduling code.
+ * @details    The scheduling code is looked up once, the selected policy is
+ * then compiled directly into the simulation loop.
  */
 void Simulator::start()
 {
-    // Executes the proper scheduling algorithm
-    if( m_config.schedulingCode == "RR" )
-        RoundRobin();
-    else if( m_config.schedulingCode == "FIFO-P" )
-        FirstInFirstOutPreEmption();
-    else if( m_config.schedulingCode == "SRTF-P" )
-        ShortestRemainingTimeFirstPreEmption();
+    std::map<std::string, Runner>::const_iterator scheduler = 
+        Schedulers.find( m_config.schedulingCode );
+
+    if( scheduler != Schedulers.end() )
+        ( this->*( scheduler->second ) )();
     else
         logger << "END" << " - ERROR SCHEDULING CODE\n";
 }
 
+/**
+ * @brief      Executes every application until completion, the policy decides
+ * which ready application is given the processor next.
+ *
+ * @tparam     Policy  The scheduling policy, see scheduler.h.
+ */
+template <typename Policy>
+void Simulator::run()
+{
+    // Simulated time runs on the simulation's own clock, which is how several
+    // processors are simulated
+    if( m_config.timeMode == "Simulated" )
+    {
+        MultiProcessor<Policy> processors( m_config, m_applications, 
+            m_operations );
+        processors.run();
+        m_applications.clear();
+        return;
+    }
+
+    Policy policy( m_config );
+
+    // Every application is ready at the start of the simulation
+    for( size_t app = 0; app < m_applications.size(); app++ )
+        policy.enqueue( &( m_applications[ app ] ) );
+
+    if( m_config.ioCompletion == "Interrupt" )
+    {
+        runInterrupts( policy );
+        m_applications.clear();
+        return;
+    }
+
+    while( !( policy.empty() ) )
+    {
+        logger << Timer::msDT() << " - OS: " << "SELECTING" 
+            << " next process\n";
+
+        // Start the next Application
+        Application* app = policy.pickNext();
+        BurstResult result = app->start( policy.timeSlice( app ) );
+
+        // Return the application to the ready queue if it is not completed
+        if( result == BurstResult::QuantumExpired )
+            policy.onPreempt( app );
+        else if( result == BurstResult::IOCompleted )
+            policy.onUnblock( app );
+    }
+
+    m_applications.clear();
+}
+
+/**
+ * @brief      Executes every application until completion, input and output
+ * complete as interrupts while the processor runs other applications.
+ * @details    An application that reaches an input or output operation arms a
+ * completion timer and gives up the processor. Completions are serviced as
+ * soon as they fire, even in the middle of another application's burst, and
+ * return their application to the ready queue. The processor only idles when
+ * every application is blocked.
+ *
+ * Input and output are charged against the quantum as the blocking loop
+ * charges them: a burst only requests as many cycles of the operation as are
+ * left of its quantum, and the rest is requested at the application's next
+ * quantum. A burst that reaches the operation with no quantum left is
+ * pre-empted.
+ *
+ * @tparam     Policy  The scheduling policy, see scheduler.h.
+ *
+ * @param      policy  The policy holding every ready application.
+ */
+template <typename Policy>
+void Simulator::runInterrupts( Policy& policy )
+{
+    Interrupts interrupts;
+    std::vector<Application*> applications;
+    std::vector<int> fired;
+
+    for( size_t app = 0; app < m_applications.size(); app++ )
+    {
+        Application* application = &( m_applications[ app ] );
+        if( application->getID() >= static_cast<int>( applications.size() ) )
+            applications.resize( application->getID() + 1, nullptr );
+        applications[ application->getID() ] = application;
+    }
+
+    // Services every completion that has fired
+    auto serviceInterrupts = [&]() {
+        for( size_t index = 0; index < fired.size(); index++ )
+        {
+            Application* app = applications[ fired[ index ] ];
+            logger << Timer::msDT() << " - Process " << app->getID() << ": "
+                << "END" << " " << app->getOperationName()
+                << ( app->isInput() ? " input\n" : " output\n" );
+
+            app->finishIOSlice();
+            if( !( app->isFinished() ) )
+                policy.onUnblock( app );
+        }
+        fired.clear();
+    };
+
+    while( !( policy.empty() ) || interrupts.pending() > 0 )
+    {
+        // The processor idles until the next interrupt
+        if( policy.empty() )
+        {
+            interrupts.waitAny( fired );
+            serviceInterrupts();
+            continue;
+        }
+
+        logger << Timer::msDT() << " - OS: " << "SELECTING" 
+            << " next process\n";
+
+        Application* app = policy.pickNext();
+        logger << Timer::msDT() << " - OS: " << "START" << " process "
+            << app->getID() << "\n";
+
+        int elapsedTime = 0;
+        int quantumTime = policy.timeSlice( app );
+        BurstResult result = app->runProcessor( quantumTime, elapsedTime );
+        int remainingQuantumTime = quantumTime - app->BurstCycles;
+        if( result == BurstResult::IOCompleted && remainingQuantumTime == 0 )
+            result = BurstResult::QuantumExpired;
+
+        // The burst runs on the processor while interrupts are serviced
+        if( elapsedTime > 0 )
+        {
+            logger << Timer::msDT() << " - Process " << app->getID() << ": " 
+                << "START" << " processing action\n";
+
+            Interrupts::Clock::time_point burstEnd = 
+                Interrupts::Clock::now() + m_operations.wallTime( elapsedTime );
+            while( Interrupts::Clock::now() < burstEnd )
+            {
+                interrupts.wait( burstEnd, fired );
+                serviceInterrupts();
+            }
+
+            logger << Timer::msDT() << " - Process " << app->getID() << ": " 
+                << "END" << " processing action\n";
+        }
+
+        logger << Timer::msDT() << " - OS: " << "END" << " process "
+            << app->getID() << "\n";
+
+        if( result == BurstResult::QuantumExpired )
+        {
+            policy.onPreempt( app );
+        }
+        else if( result == BurstResult::IOCompleted )
+        {
+            logger << Timer::msDT() << " - Process " << app->getID() << ": "
+                << "START" << " " << app->getOperationName()
+                << ( app->isInput() ? " input\n" : " output\n" );
+            long long time = app->startIOSlice( remainingQuantumTime );
+            interrupts.arm( m_operations.wallTime( time ).count(), 
+                app->getID() );
+        }
+    }
+}
+
 //
 // SCHEDULING CODES ////////////////////////////////////////////////////////////
 //
 
+/**
+ * @brief      Every scheduling code that may be given in the config, and the
+ * policy that implements it.
+ * @details    Parser::TextKeys lists the same codes to check the config.
+ */
+const std::map<std::string, Simulator::Runner> Simulator::Schedulers = {
+    { "RR", &Simulator::run<RoundRobinPolicy> },
+    { "FIFO-P", &Simulator::run<FirstInFirstOutPreEmptionPolicy> },
+    { "SRTF-P", &Simulator::run<ShortestRemainingTimeFirstPreEmptionPolicy> },
+    { "CFS", &Simulator::run<CompletelyFairSchedulerPolicy> },
+    { "MLFQ", &Simulator::run<MultiLevelFeedbackQueuePolicy> },
+    { "LOTTERY", &Simulator::run<LotteryPolicy> },
+    { "STRIDE", &Simulator::run<StridePolicy> }
+};
+
 /**
  * @brief      Builds the First In First Out scheduling code.
  * @details    This function will create applications and give every application
@@ -53,151 +253,267 @@ void Simulator::start()
  *
  * @param[in]  operations  The full list of operations to build from.
  */
-void Simulator::buildFIFO( std::list<std::string> operations )
+void Simulator::buildFIFO( const std::list<std::string>& operations )
 {
     // Give each application a unique ID
     int appID = 0;
+    int coalesced = 0;
+    long long arrival = 0;
+
+    // The workload lives in the arena, which a container only fills without
+    // waste if it never grows
+    m_operations.reserve( operations.size() );
+    m_applications.reserve( std::count_if( operations.begin(), 
+        operations.end(), []( const std::string& operation ) {
+            return operation.compare( 0, 8, "A(start)" ) == 0;
+        } ) );
 
     // Builds the simulator's operations by creating applications
     // that contains their own operations
-    std::list<std::string>::iterator operationsIter = operations.begin();
-    while( !( operations.empty() ) )
+    OperationRecord record;
+    std::list<std::string>::const_iterator operationsIter = 
+        operations.begin();
+    while( operationsIter != operations.end() )
     {
-        std::map<std::string, std::string> opMap = Parser::splitOperation(
-            *operationsIter );
-
-        Operation operation( m_config, appID, opMap["Component"], 
-            opMap["Operation"], std::stoi( opMap["Cycle"] ) );
-
         // If the operation is an Application, extract the operations and give it to
         // the operation until that application's section is over
-        if( operation.Component == "A" && operation.Name == "start" )
+        if( parse( *operationsIter, record ) && record.Component == 'A' && 
+            Parser::isNamed( *operationsIter, record, "start" ) )
         {
             appID++;
-            // Removes "Application Start"
-            operations.erase( operationsIter++ );
+            // The cycles of "A(start)" are the application's lottery tickets
+            int tickets = record.Cycles;
+            // Skips "Application Start"
+            ++operationsIter;
 
-            // Create a temp list for all of the app's operations
-            std::list<Operation> applicationOperations;
+            // The app's operations are the rows added until its section ends
+            size_t first = m_operations.size();
+            int position = 0;
 
-            opMap = Parser::splitOperation( *operationsIter );
-            operation = Operation( m_config, appID, opMap["Component"], 
-                opMap["Operation"], std::stoi( opMap["Cycle"] ) );
             // Add each operation until the app's section ends
-            while( operation.Component != "A" && operation.Name != "stop" )
+            for( ; operationsIter != operations.end(); ++operationsIter )
             {
-                applicationOperations.push_back( operation );
-                operations.erase( operationsIter++ );
+                if( !( parse( *operationsIter, record ) ) )
+                    continue;
+                // "A(arrive)" gives the time since the last application arrived
+                if( record.Component == 'A' && 
+                    Parser::isNamed( *operationsIter, record, "arrive" ) )
+                {
+                    arrival += record.Cycles;
+                    continue;
+                }
+                if( record.Component == 'A' || 
+                    Parser::isNamed( *operationsIter, record, "stop" ) )
+                {
+                    break;
+                }
+
+                Operation operation( record.Component, 
+                    operationsIter->data() + record.NameStart, 
+                    record.NameLength, record.Cycles );
 
-                opMap = Parser::splitOperation( *operationsIter );
-                operation = Operation( m_config, appID, opMap["Component"], 
-                    opMap["Operation"], std::stoi( opMap["Cycle"] ) );
+                // Each operation's device address is derived from its position
+                operation.Address = Random::hash( appID, position++ );
+                if( addOperation( first, operation ) )
+                    coalesced++;
             }
 
-            // Create the new application with the extracted operations
-            Application app( m_config, appID, applicationOperations );
-            // Give it to the simulator's application list
-            m_applications.push_back( app );
+            addApplication( appID, first, tickets, arrival );
+
+            if( operationsIter == operations.end() )
+                break;
         }
-        // Removes "Simulation End" or any operations that do not belong
+        // Skips "Simulation End" or any operations that do not belong
         // to any application 
-        operations.erase( operationsIter++ );
+        ++operationsIter;
     }
+
+    logPrepared( coalesced );
 }
 
-void Simulator::RoundRobin()
+/**
+ * @brief      Receives a generated workload, see Generator, and builds it
+ * exactly as buildFIFO() builds the same workload's meta-data.
+ */
+struct Simulator::Builder
 {
-    // Iterate through all of the applications within the simulation
-    std::list<Application>::iterator appIterator = m_applications.begin();
-    while( !( m_applications.empty() ) )
+    explicit Builder( Simulator& simulator )
+        :   Owner( simulator ), AppID( 0 ), First( 0 ), Position( 0 ),
+            Arrival( 0 ), Coalesced( 0 )
     {
-        logger << Timer::msDT() << " - OS: " << "SELECTING" 
-            << " next process\n";
+    }
 
-        // Do not select any I/O blocked applications
-        while( appIterator == m_applications.end() || 
-               appIterator->Blocked == true )
-        {
-            if( appIterator == m_applications.end() )
-                appIterator = m_applications.begin();
-            else
-                appIterator++;
-        }
+    void startProgram()
+    {
+        AppID++;
+        First = Owner.m_operations.size();
+        Position = 0;
+    }
 
-        // Start the next Application
-        appIterator->start();
-        if( appIterator->ApplicationTime == 0 )
-            m_applications.erase( appIterator++ );
-        else
-            appIterator++;
+    void arrive( int gap )
+    {
+        Arrival += gap;
+    }
+
+    void operation( const GeneratedOperation& generated, int cycles )
+    {
+        Operation operation( generated.Component, generated.Name,
+            std::strlen( generated.Name ), cycles );
+        operation.Address = Random::hash( AppID, Position++ );
+        if( Owner.addOperation( First, operation ) )
+            Coalesced++;
     }
+
+    void endProgram()
+    {
+        Owner.addApplication( AppID, First, 0, Arrival );
+    }
+
+    Simulator& Owner;
+    int AppID;
+    size_t First;
+    int Position;
+    long long Arrival;
+    int Coalesced;
+};
+
+/**
+ * @brief      Builds the First In First Out scheduling code from a generated
+ * workload, which is drawn straight into the operation table.
+ *
+ * @param[in]  workload  The options of the workload to generate.
+ */
+void Simulator::buildGenerated( const GeneratorOptions& workload )
+{
+    // Every program has the same number of operations, so both containers
+    // are reserved exactly
+    m_operations.reserve( workload.programs * workload.operations );
+    m_applications.reserve( workload.programs );
+
+    Builder builder( *this );
+    Generator generator( workload );
+    generator.generate( builder );
+
+    logPrepared( builder.Coalesced );
 }
 
-void Simulator::FirstInFirstOutPreEmption()
+/**
+ * @brief      Adds an operation to the end of the application being built.
+ * @details    Back-to-back transfers on a coalesced device become one.
+ *
+ * @param[in]  first      The row of the application's first operation.
+ * @param[in]  operation  The operation, with its device address.
+ *
+ * @return     True if the operation was merged into the one before it, false
+ * if it was added.
+ */
+bool Simulator::addOperation( size_t first, const Operation& operation )
 {
-    // Iterate through all of the applications within the simulation
-    std::list<Application>::iterator appIterator = m_applications.begin();
-    while( !( m_applications.empty() ) )
+    // A row too full for the cycles keeps them as an operation of their own
+    if( coalesces( first, operation ) && m_operations.addCycles( 
+        m_operations.size() - 1, operation.RemainingCycles ) )
     {
-        logger << Timer::msDT() << " - OS: " << "SELECTING" 
-            << " next process\n";
+        return true;
+    }
 
-        // Do not select any I/O blocked applications
-        while( appIterator == m_applications.end() || 
-               appIterator->Blocked == true )
-        {
-            if( appIterator == m_applications.end() )
-                appIterator = m_applications.begin();
-            else
-                appIterator++;
-        }
+    m_operations.add( operation );
+    return false;
+}
 
-        // First In First Out, if the front of the list is not
-        // blocked, execute it, because it came in first
-        if( m_applications.begin()->Blocked == false )
-            appIterator = m_applications.begin();
+/**
+ * @brief      Creates an application in place in the simulator's application
+ * list, from the operations added since its first.
+ *
+ * @param[in]  appID    The application's ID.
+ * @param[in]  first    The row of the application's first operation.
+ * @param[in]  tickets  The application's lottery tickets, 0 for the default.
+ * @param[in]  arrival  When the application arrives, in ms.
+ */
+void Simulator::addApplication( int appID, size_t first, int tickets,
+    long long arrival )
+{
+    m_applications.emplace_back( m_config, appID, m_operations, 
+        first, m_operations.size() );
+    if( tickets > 0 )
+        m_applications.back().Tickets = tickets;
+    m_applications.back().Arrival = arrival;
+}
 
-        // Start the next Application
-        appIterator->start();
+/**
+ * @brief      Logs the footprint of the prepared workload.
+ *
+ * @param[in]  coalesced  The number of I/O operations that were coalesced.
+ */
+void Simulator::logPrepared( int coalesced )
+{
+    // Every process is a small frame resumed by the scheduler, not a thread
+    size_t footprint = 0;
+    for( size_t app = 0; app < m_applications.size(); app++ )
+        footprint += m_applications[ app ].footprint();
+    logger << Timer::msDT() << " - OS: " << "PREPARED" << " " 
+        << static_cast<int>( m_applications.size() ) << " processes, "
+        << static_cast<int>( sizeof( Application ) ) << " byte frames, "
+        << static_cast<float>( m_applications.empty() ? 0.0 : 
+            static_cast<double>( footprint ) / m_applications.size() )
+        << " bytes each with operations, "
+        << static_cast<int>( m_arena.reserved() / 1024 ) << " KB arena in "
+        << m_arena.allocations() << " allocations\n";
 
-        // Remove the application if it is completed
-        if( appIterator->ApplicationTime == 0 )
-            m_applications.erase( appIterator++ );
-        else
-            appIterator++;
+    if( !( m_config.coalescedDevices.empty() ) )
+    {
+        logger << Timer::msDT() << " - OS: " << "COALESCED" << " " 
+            << coalesced << " I/O operations\n";
     }
 }
 
-void Simulator::ShortestRemainingTimeFirstPreEmption()
+/**
+ * @brief      Parses one meta-data operation, reporting it if it is malformed.
+ *
+ * @param[in]  operation  The operation as written, such as "P(run)6".
+ * @param[out] record     The parsed operation.
+ *
+ * @return     True if the operation is well formed, false if it should be
+ * skipped.
+ */
+bool Simulator::parse( const std::string& operation, OperationRecord& record )
 {
-    // Iterate through all of the applications within the simulation
-    
-    while( !( m_applications.empty() ) )
-    {
-        logger << Timer::msDT() << " - OS: " << "SELECTING" 
-            << " next process\n";
+    if( Parser::parseOperation( operation, record ) )
+        return true;
 
-        // Arrange the applications by shortest remaining time
-        m_applications.sort();
-        std::list<Application>::iterator appIterator = m_applications.begin();
+    std::cout << "WARNING: Skipping malformed operation \"" << operation 
+        << "\", " << record.Error << "." << std::endl;
+    return false;
+}
 
-        // Do not select any I/O blocked applications
-        while( appIterator == m_applications.end() || 
-               appIterator->Blocked == true )
-        {
-            if( appIterator == m_applications.end() )
-                appIterator = m_applications.begin();
-            else
-                appIterator++;
-        }
+/**
+ * @brief      Whether an operation joins the last operation of its
+ * application instead of becoming a request of its own.
+ * @details    Only adjacent input or output operations on the same device
+ * coalesce, and only on a device listed in the config.
+ *
+ * @param[in]  first      The row of the application's first operation.
+ * @param[in]  operation  The operation that follows its last operation.
+ *
+ * @return     True if the operation should be merged, false otherwise.
+ */
+bool Simulator::coalesces( size_t first, const Operation& operation ) const
+{
+    if( m_operations.size() == first || !( operation.isIO() ) )
+        return false;
 
-        // Start the next Application
-        appIterator->start();
+    size_t previous = m_operations.size() - 1;
+    if( !( m_operations.isIO( previous ) ) || 
+        m_operations.isInput( previous ) != ( operation.Component == 'I' ) ||
+        !( operation.isNamed( m_operations.getName( previous ) ) ) )
+    {
+        return false;
+    }
 
-        // Remove the application if it is completed
-        if( appIterator->ApplicationTime == 0 )
-            m_applications.erase( appIterator++ );
-        else
-            appIterator++;
+    for( size_t device = 0; device < m_config.coalescedDevices.size();
+         device++ )
+    {
+        if( operation.isNamed( m_config.coalescedDevices[ device ] ) )
+            return true;
     }
-}
\ No newline at end of file
+    return false;
+}
@@ -3,30 +3,53 @@
 
 #include <list>
 #include <map>
+#include <vector>
 #include <algorithm>
+#include <cstring>
 
+#include "Tools/arena.h"
 #include "Tools/log.h"
 #include "Tools/config.h"
+#include "Tools/generator.h"
 #include "Tools/parser.h"
 #include "Tools/timer.h"
+#include "Tools/random.h"
+#include "Tools/interrupts.h"
 
 #include "application.h"
 #include "operation.h"
+#include "operationtable.h"
+#include "scheduler.h"
+#include "multiprocessor.h"
 
 class Simulator
 {
 public:
-    Simulator( Config config, std::list<std::string> operations );
+    Simulator( const Config& config, std::list<std::string> operations );
+    Simulator( const Config& config, const GeneratorOptions& workload );
     void start();
 
 private:
-    void buildFIFO( std::list<std::string> operations );
-    void RoundRobin();
-    void FirstInFirstOutPreEmption();
-    void ShortestRemainingTimeFirstPreEmption();
+    typedef void ( Simulator::*Runner )();
+    struct Builder;
+
+    void buildFIFO( const std::list<std::string>& operations );
+    void buildGenerated( const GeneratorOptions& workload );
+    static bool parse( const std::string& operation, OperationRecord& record );
+    bool addOperation( size_t first, const Operation& operation );
+    void addApplication( int appID, size_t first, int tickets,
+        long long arrival );
+    void logPrepared( int coalesced );
+    bool coalesces( size_t first, const Operation& operation ) const;
+    template <typename Policy> void run();
+    template <typename Policy> void runInterrupts( Policy& policy );
+
+    static const std::map<std::string, Runner> Schedulers;
 
     Config m_config;
-    std::list<Application> m_applications;
+    Arena m_arena;
+    OperationTable m_operations;
+    ApplicationList m_applications;
 };
 
 #endif  //  SIMULATOR_H
\ No newline at end of file
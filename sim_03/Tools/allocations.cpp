@@ -0,0 +1,103 @@
+#include "allocations.h"
+
+#ifdef COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<unsigned long long> allocationCount( 0 );
+    std::atomic<unsigned long long> allocationBytes( 0 );
+
+    /**
+     * @brief      Counts and makes one allocation.
+     *
+     * @param[in]  size  The bytes requested.
+     *
+     * @return     The allocated memory.
+     */
+    void* countedAllocate( std::size_t size )
+    {
+        allocationCount.fetch_add( 1, std::memory_order_relaxed );
+        allocationBytes.fetch_add( size, std::memory_order_relaxed );
+
+        void* memory = std::malloc( size == 0 ? 1 : size );
+        if( memory == nullptr )
+            throw std::bad_alloc();
+        return memory;
+    }
+}
+
+//
+// REPLACED OPERATORS //////////////////////////////////////////////////////////
+//
+
+void* operator new( std::size_t size )
+{
+    return countedAllocate( size );
+}
+
+void* operator new[]( std::size_t size )
+{
+    return countedAllocate( size );
+}
+
+void operator delete( void* memory ) noexcept
+{
+    std::free( memory );
+}
+
+void operator delete[]( void* memory ) noexcept
+{
+    std::free( memory );
+}
+
+#endif
+
+//
+// STATIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Whether allocations are being counted in this build.
+ *
+ * @return     True if built with COUNT_ALLOCATIONS, false otherwise.
+ */
+bool Allocations::enabled()
+{
+#ifdef COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief      The number of allocations made so far.
+ *
+ * @return     The count, 0 if allocations are not counted.
+ */
+unsigned long long Allocations::count()
+{
+#ifdef COUNT_ALLOCATIONS
+    return allocationCount.load( std::memory_order_relaxed );
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief      The bytes requested by every allocation made so far.
+ *
+ * @return     The bytes, 0 if allocations are not counted.
+ */
+unsigned long long Allocations::bytes()
+{
+#ifdef COUNT_ALLOCATIONS
+    return allocationBytes.load( std::memory_order_relaxed );
+#else
+    return 0;
+#endif
+}
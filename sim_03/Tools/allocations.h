@@ -0,0 +1,18 @@
+#ifndef ALLOCATIONS_H
+#define ALLOCATIONS_H
+
+/**
+ * @brief      Counts every heap allocation the program makes.
+ * @details    The counters are only kept in a build made with
+ * "make ALLOCATIONS=count", which replaces the global operator new and
+ * operator delete. Otherwise every count is 0 and enabled() is false.
+ */
+class Allocations
+{
+public:
+    static bool enabled();
+    static unsigned long long count();
+    static unsigned long long bytes();
+};
+
+#endif  //  ALLOCATIONS_H
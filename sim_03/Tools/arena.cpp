@@ -0,0 +1,107 @@
+#include "arena.h"
+
+#include <new>
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for an empty arena, the first block is
+ * taken on the first allocation.
+ */
+Arena::Arena()
+    :   m_next( nullptr ), m_left( 0 ), m_allocated( 0 ), m_reserved( 0 ),
+        m_allocations( 0 )
+{
+}
+
+/**
+ * @brief      Frees every block, and with them everything allocated.
+ */
+Arena::~Arena()
+{
+    for( size_t block = 0; block < m_blocks.size(); block++ )
+        ::operator delete( m_blocks[ block ] );
+}
+
+//
+// ALLOCATION //////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Allocates memory that lives until the arena is destroyed.
+ * @details    A request larger than a quarter of a block gets a block of its
+ * own, so that a large container does not waste the rest of the current
+ * block.
+ *
+ * @param[in]  bytes      The bytes requested.
+ * @param[in]  alignment  The alignment required, a power of two.
+ *
+ * @return     The memory.
+ */
+void* Arena::allocate( size_t bytes, size_t alignment )
+{
+    m_allocated += bytes;
+    m_allocations++;
+
+    if( bytes > BlockBytes / 4 )
+    {
+        char* block = static_cast<char*>( ::operator new( bytes ) );
+        m_blocks.push_back( block );
+        m_reserved += bytes;
+        return block;
+    }
+
+    size_t padding = reinterpret_cast<size_t>( m_next ) & ( alignment - 1 );
+    if( padding != 0 )
+        padding = alignment - padding;
+
+    if( m_next == nullptr || padding + bytes > m_left )
+    {
+        m_next = static_cast<char*>( ::operator new( BlockBytes ) );
+        m_blocks.push_back( m_next );
+        m_left = BlockBytes;
+        m_reserved += BlockBytes;
+        padding = 0;
+    }
+
+    void* memory = m_next + padding;
+    m_next += padding + bytes;
+    m_left -= padding + bytes;
+    return memory;
+}
+
+//
+// ACCESSORS ///////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      The bytes handed out so far.
+ *
+ * @return     The bytes.
+ */
+size_t Arena::allocated() const
+{
+    return m_allocated;
+}
+
+/**
+ * @brief      The bytes taken from the heap so far.
+ *
+ * @return     The bytes.
+ */
+size_t Arena::reserved() const
+{
+    return m_reserved;
+}
+
+/**
+ * @brief      The number of allocations handed out so far.
+ *
+ * @return     The count.
+ */
+int Arena::allocations() const
+{
+    return m_allocations;
+}
@@ -0,0 +1,98 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief      Memory that lives exactly as long as one simulation, handed out
+ * by bumping a pointer through large blocks and freed in one shot when the
+ * arena is destroyed.
+ * @details    Nothing given out is freed on its own, so an arena suits the
+ * workload, which is built once before the simulation runs and kept until it
+ * ends. Containers should reserve their final size up front, since growing
+ * leaves the old memory unused until the arena is destroyed.
+ */
+class Arena
+{
+public:
+    Arena();
+    ~Arena();
+
+    void* allocate( size_t bytes, size_t alignment );
+    size_t allocated() const;
+    size_t reserved() const;
+    int allocations() const;
+
+    Arena( const Arena& ) = delete;
+    Arena& operator=( const Arena& ) = delete;
+
+private:
+    static const size_t BlockBytes = 1024 * 1024;
+
+    std::vector<char*> m_blocks;
+    char* m_next;
+    size_t m_left;
+    size_t m_allocated;
+    size_t m_reserved;
+    int m_allocations;
+};
+
+/**
+ * @brief      A standard allocator that takes its memory from an Arena, for
+ * containers that are filled once and kept for the whole simulation.
+ *
+ * @tparam     T     The type allocated.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator( Arena& arena )
+        :   m_arena( &arena )
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator( const ArenaAllocator<U>& other )
+        :   m_arena( other.arena() )
+    {
+    }
+
+    T* allocate( size_t count )
+    {
+        return static_cast<T*>( m_arena->allocate( count * sizeof( T ),
+            alignof( T ) ) );
+    }
+
+    // The memory is freed with the arena
+    void deallocate( T*, size_t )
+    {
+    }
+
+    Arena* arena() const
+    {
+        return m_arena;
+    }
+
+private:
+    Arena* m_arena;
+};
+
+template <typename T, typename U>
+bool operator==( const ArenaAllocator<T>& first,
+    const ArenaAllocator<U>& second )
+{
+    return first.arena() == second.arena();
+}
+
+template <typename T, typename U>
+bool operator!=( const ArenaAllocator<T>& first,
+    const ArenaAllocator<U>& second )
+{
+    return first.arena() != second.arena();
+}
+
+#endif  //  ARENA_H
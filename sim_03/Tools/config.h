@@ -2,6 +2,7 @@
 #define CONFIG_H
 
 #include <string>
+#include <vector>
 
 /**
  * @brief      Mimics a .cnf file.
@@ -20,6 +21,45 @@ public:
     int keyboardCycle;
     std::string log;
     std::string logFilePath;
+
+    // Optional settings, every line may be given in any order
+    int targetLatency = 24;
+    int minimumGranularity = 3;
+    std::vector<int> feedbackQuanta = { 3, 6, 12 };
+    int feedbackBoostPeriod = 200;
+    int defaultTickets = 100;
+    unsigned long long randomSeed = 1;
+    int processors = 1;
+    int migrationCost = 1;
+    int hostThreads = 1;
+    std::string synchronization = "Windows";
+    int cacheWarmup = 0;
+    int cacheDecay = 50;
+    std::string placement = "Balance";
+    int hardDrives = 1;
+    int keyboards = 1;
+    int monitors = 1;
+    int printers = 1;
+    int deviceSamplePeriod = 0;
+    int cylinders = 0;
+    int seekTime = 100;
+    int rotationalLatency = 4;
+    std::string diskScheduling = "FCFS";
+    int bufferCacheBlocks = 0;
+    std::string bufferCacheReplacement = "LRU";
+    int bufferCacheHitTime = 1;
+    int diskBlocks = 4096;
+    int monitorSpool = 0;
+    int printerSpool = 0;
+    int hardDriveSetup = 0;
+    int keyboardSetup = 0;
+    int monitorSetup = 0;
+    int printerSetup = 0;
+    std::vector<std::string> coalescedDevices;
+    std::string ioCompletion = "Blocking";
+    std::string timeMode = "Real";
+    float timeScale = 1.0f;
+    std::string logLevel = "Events";
 };
 
 #endif  //  CONFIG_H
\ No newline at end of file
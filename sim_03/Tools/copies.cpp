@@ -0,0 +1,54 @@
+#include "copies.h"
+
+#ifdef COUNT_COPIES
+
+#include <atomic>
+
+namespace
+{
+    std::atomic<unsigned long long> copyCount( 0 );
+}
+
+#endif
+
+//
+// STATIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Whether copies are being counted in this build.
+ *
+ * @return     True if built with COUNT_COPIES, false otherwise.
+ */
+bool Copies::enabled()
+{
+#ifdef COUNT_COPIES
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief      The number of moves made so far.
+ *
+ * @return     The count, 0 if copies are not counted.
+ */
+unsigned long long Copies::count()
+{
+#ifdef COUNT_COPIES
+    return copyCount.load( std::memory_order_relaxed );
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief      Counts one move.
+ */
+void Copies::add()
+{
+#ifdef COUNT_COPIES
+    copyCount.fetch_add( 1, std::memory_order_relaxed );
+#endif
+}
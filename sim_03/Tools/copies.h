@@ -0,0 +1,41 @@
+#ifndef COPIES_H
+#define COPIES_H
+
+/**
+ * @brief      Counts every time an application or operation of the workload is
+ * moved, which copying them would do too if it were allowed.
+ * @details    The counters are only kept in a build with COUNT_COPIES
+ * defined, such as "make copies", where Application and Operation hold a
+ * Counter. Otherwise every count is 0 and enabled() is false.
+ */
+class Copies
+{
+public:
+    /**
+     * @brief      A member that counts every time the object holding it is
+     * moved.
+     */
+    struct Counter
+    {
+        Counter()
+        {
+        }
+
+        Counter( Counter&& )
+        {
+            Copies::add();
+        }
+
+        Counter& operator=( Counter&& )
+        {
+            Copies::add();
+            return *this;
+        }
+    };
+
+    static bool enabled();
+    static unsigned long long count();
+    static void add();
+};
+
+#endif  //  COPIES_H
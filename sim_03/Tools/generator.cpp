@@ -0,0 +1,305 @@
+#include "generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "workers.h"
+
+//
+// PROFILES ////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Every profile other than "Uniform" and "Mixed", see Profile.
+ */
+const std::map<std::string, Generator::Profile> Generator::Profiles = {
+    { "CPU-bound", { 90, 50, 33, 33, 4, 1 } },
+    { "I/O-bound", { 20, 80, 70, 33, 1, 2 } },
+    { "Interactive", { 40, 10, 10, 90, 1, 1 } }
+};
+
+//
+// OPERATIONS //////////////////////////////////////////////////////////////////
+//
+
+const GeneratedOperation Generator::Run = { 'P', "run", "P(run)", 6 };
+const GeneratedOperation Generator::HardDriveInput = 
+    { 'I', "hard drive", "I(hard drive)", 13 };
+const GeneratedOperation Generator::KeyboardInput = 
+    { 'I', "keyboard", "I(keyboard)", 11 };
+const GeneratedOperation Generator::HardDriveOutput = 
+    { 'O', "hard drive", "O(hard drive)", 13 };
+const GeneratedOperation Generator::MonitorOutput = 
+    { 'O', "monitor", "O(monitor)", 10 };
+const GeneratedOperation Generator::PrinterOutput = 
+    { 'O', "printer", "O(printer)", 10 };
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for a generator.
+ *
+ * @param[in]  options  What the workload contains, its profile and bursts must
+ * be known, see hasProfile() and hasBursts().
+ */
+Generator::Generator( const GeneratorOptions& options )
+    :   m_options( options ), m_bursts( Bursts::Uniform ),
+        m_uniform( Profile{ options.processingPercent, 50, 33, 33, 1, 1 } ),
+        m_profile( &m_uniform )
+{
+    if( m_options.bursts == "Pareto" )
+        m_bursts = Bursts::Pareto;
+    else if( m_options.bursts == "Lognormal" )
+        m_bursts = Bursts::Lognormal;
+
+    // A mixed population draws the profile of every program
+    if( m_options.profile == "Mixed" )
+        m_profile = nullptr;
+    else if( Profiles.count( m_options.profile ) > 0 )
+        m_profile = &( Profiles.at( m_options.profile ) );
+}
+
+/**
+ * @brief      Whether a profile exists.
+ *
+ * @param[in]  profile  The profile, such as "Interactive".
+ *
+ * @return     True if the profile exists, false otherwise.
+ */
+bool Generator::hasProfile( const std::string& profile )
+{
+    return profile == "Uniform" || profile == "Mixed" || 
+        Profiles.count( profile ) > 0;
+}
+
+/**
+ * @brief      Whether a bursts distribution exists.
+ *
+ * @param[in]  bursts  The distribution, such as "Pareto".
+ *
+ * @return     True if the distribution exists, false otherwise.
+ */
+bool Generator::hasBursts( const std::string& bursts )
+{
+    return bursts == "Uniform" || bursts == "Pareto" || bursts == "Lognormal";
+}
+
+//
+// WRITING /////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Writes the whole workload, from the "Start Program Meta-Data
+ * Code:" line to the "End Program Meta-Data Code." line.
+ * @details    Each round formats a batch per worker index in parallel, then
+ * writes the batches in order while the workers wait for the next round.
+ *
+ * @param      stream  The stream to write to.
+ */
+void Generator::write( std::ostream& stream )
+{
+    static const char header[] = "Start Program Meta-Data Code:\nS(start)0;\n";
+    static const char footer[] = "S(end)0.\nEnd Program Meta-Data Code.\n";
+
+    Workers workers( m_options.threads );
+
+    // A batch holds as many whole programs as fit in its buffer
+    size_t programBytes = ( m_options.operations + 2 ) * OperationBytes + 1;
+    long long programsPerBatch = std::max<long long>( 1,
+        BatchBytes / programBytes );
+    std::vector<Batch> batches( workers.size() * BatchesPerThread );
+    for( size_t index = 0; index < batches.size(); index++ )
+        batches[ index ].Buffer.resize( programsPerBatch * programBytes );
+
+    stream.write( header, sizeof( header ) - 1 );
+    long long programs = m_options.programs;
+    long long round = programsPerBatch * batches.size();
+    for( long long first = 0; first < programs; first += round )
+    {
+        workers.run( static_cast<int>( batches.size() ), [&]( int index ) {
+            long long begin = std::min( programs,
+                first + index * programsPerBatch );
+            writeBatch( batches[ index ], begin,
+                std::min( programs, begin + programsPerBatch ) );
+        } );
+
+        for( size_t index = 0; index < batches.size(); index++ )
+        {
+            stream.write( batches[ index ].Buffer.data(),
+                batches[ index ].Size );
+        }
+    }
+    stream.write( footer, sizeof( footer ) - 1 );
+}
+
+/**
+ * @brief      Formats a range of programs into a batch, replacing its text.
+ *
+ * @param      batch  The batch.
+ * @param[in]  first  The index of the first program.
+ * @param[in]  last   The index after the last program.
+ */
+void Generator::writeBatch( Batch& batch, long long first,
+    long long last ) const
+{
+    batch.Size = 0;
+    for( long long program = first; program < last; program++ )
+        drawProgram( batch, program );
+}
+
+/**
+ * @brief      Starts a program on a new line with "A(start)0;".
+ */
+void Generator::Batch::startProgram()
+{
+    LineLength = 0;
+    writeOperation( *this, "A(start)", 8, 0 );
+}
+
+/**
+ * @brief      Formats the time since the previous program arrived.
+ *
+ * @param[in]  gap   The time in ms.
+ */
+void Generator::Batch::arrive( int gap )
+{
+    writeOperation( *this, "A(arrive)", 9, gap );
+}
+
+/**
+ * @brief      Formats a drawn operation.
+ *
+ * @param[in]  operation  The operation.
+ * @param[in]  cycles     Its cycles.
+ */
+void Generator::Batch::operation( const GeneratedOperation& operation,
+    int cycles )
+{
+    writeOperation( *this, operation.Text, operation.Length, cycles );
+}
+
+/**
+ * @brief      Ends a program with "A(end)0;" and its line.
+ */
+void Generator::Batch::endProgram()
+{
+    writeOperation( *this, "A(end)", 6, 0 );
+    append( *this, "\n", 1 );
+}
+
+/**
+ * @brief      Draws the profile of a program in a mixed population, two in
+ * five are CPU-bound, and the rest I/O-bound or interactive in equal parts.
+ *
+ * @param      random  The program's stream.
+ *
+ * @return     The program's profile.
+ */
+const Generator::Profile& Generator::drawProfile( Random& random ) const
+{
+    int draw = static_cast<int>( random.below32( 100 ) );
+    if( draw < 40 )
+        return Profiles.at( "CPU-bound" );
+    else if( draw < 70 )
+        return Profiles.at( "I/O-bound" );
+    return Profiles.at( "Interactive" );
+}
+
+/**
+ * @brief      Draws the cycles of an operation from the bursts distribution.
+ * @details    Pareto bursts have a shape of 1.5, so most are short and a few
+ * are very long. Lognormal bursts have a sigma of 1.
+ *
+ * @param      random  The program's stream.
+ * @param[in]  scale   The profile's scale of the mean for this operation.
+ *
+ * @return     The cycles, at least 1.
+ */
+int Generator::drawCycles( Random& random, int scale ) const
+{
+    if( m_bursts == Bursts::Uniform )
+    {
+        return scale * ( CyclesMinimum + static_cast<int>( 
+            random.below32( CyclesMaximum - CyclesMinimum + 1 ) ) );
+    }
+
+    static const double Pi = 3.14159265358979323846;
+    double mean = static_cast<double>( CyclesMean ) * scale;
+    double cycles;
+    if( m_bursts == Bursts::Pareto )
+    {
+        // The scale of a shape 1.5 Pareto is a third of its mean
+        cycles = mean / 3.0 / std::pow( random.fraction(), 1.0 / 1.5 );
+    }
+    else
+    {
+        // Box-Muller, the median of a sigma 1 lognormal is its mean / e^0.5
+        double normal = std::sqrt( -2.0 * std::log( random.fraction() ) ) *
+            std::cos( 2.0 * Pi * random.fraction() );
+        cycles = std::exp( std::log( mean ) - 0.5 + normal );
+    }
+
+    return static_cast<int>( std::max( 1.0, 
+        std::round( std::min( cycles, mean * CyclesCap ) ) ) );
+}
+
+/**
+ * @brief      Formats one operation followed by ";" into a batch, starting a
+ * new line first if the operation would not fit on the current one.
+ *
+ * @param      batch      The batch to write to.
+ * @param[in]  operation  The operation without its cycles, such as "P(run)".
+ * @param[in]  length     The length of the operation.
+ * @param[in]  cycles     The cycles of the operation.
+ */
+void Generator::writeOperation( Batch& batch, const char* operation,
+    size_t length, int cycles )
+{
+    // Digits are formatted from the last
+    char digits[ 12 ];
+    char* first = digits + sizeof( digits );
+    do
+    {
+        *--first = static_cast<char>( '0' + cycles % 10 );
+        cycles /= 10;
+    }
+    while( cycles > 0 );
+    size_t digitCount = digits + sizeof( digits ) - first;
+
+    size_t total = length + digitCount + 1;
+    if( batch.LineLength > 0 )
+    {
+        if( batch.LineLength + 1 + total > LineLength )
+        {
+            append( batch, "\n", 1 );
+            batch.LineLength = 0;
+        }
+        else
+        {
+            append( batch, " ", 1 );
+            batch.LineLength++;
+        }
+    }
+
+    append( batch, operation, length );
+    append( batch, first, digitCount );
+    append( batch, ";", 1 );
+    batch.LineLength += total;
+}
+
+/**
+ * @brief      Copies text to the end of a batch, whose buffer is sized for
+ * the longest batch of programs.
+ *
+ * @param      batch   The batch.
+ * @param[in]  text    The text.
+ * @param[in]  length  The length of the text.
+ */
+void Generator::append( Batch& batch, const char* text, size_t length )
+{
+    std::memcpy( &( batch.Buffer[ batch.Size ] ), text, length );
+    batch.Size += length;
+}
@@ -0,0 +1,235 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "random.h"
+
+/**
+ * @brief      What a generated workload contains.
+ */
+struct GeneratorOptions
+{
+    int processingPercent = 50;
+    int operations = 10;
+    long long programs = 1;
+    uint64_t seed = 1;
+    int threads = 1;
+    std::string profile = "Uniform";
+    std::string bursts = "Uniform";
+    int meanArrival = 0;
+};
+
+/**
+ * @brief      An operation the generator draws, with its meta-data text.
+ */
+struct GeneratedOperation
+{
+    char Component;
+    const char* Name;
+    const char* Text;
+    size_t Length;
+};
+
+/**
+ * @brief      Draws a seeded workload, and writes it in the meta-data operation
+ * format or hands its operations straight to a sink.
+ * @details    Each program draws its operations from its profile: processing
+ * with the profile's percentage, otherwise input and output in turn, each on
+ * a device drawn with the profile's odds. The "Uniform" profile is the
+ * original generator, with the given processing percentage. "CPU-bound",
+ * "I/O-bound" and "Interactive" programs favour long bursts, the hard drive,
+ * and the keyboard and monitor respectively, and "Mixed" draws one of those
+ * three for each program.
+ *
+ * Cycles are drawn from the bursts distribution with a mean of 10, scaled by
+ * the profile: "Uniform" between 5 and 15 as before, or the heavy-tailed
+ * "Pareto" and "Lognormal", which are capped at 100 times their mean. With a
+ * mean arrival time programs arrive as a Poisson process, each program's
+ * "A(arrive)" gives the ms since the one before it.
+ *
+ * Every program draws from its own stream, seeded by the seed and the
+ * program's index, and starts on a new line, so its text does not depend on
+ * any other program. Batches of programs are formatted on several threads at
+ * once and written in order, so the file is the same for any thread count.
+ *
+ * A sink is any class with startProgram(), arrive( int gap ),
+ * operation( const GeneratedOperation& operation, int cycles ) and
+ * endProgram(), which generate() calls for every program in order, so a
+ * workload can be built in memory without formatting or parsing any text.
+ */
+class Generator
+{
+public:
+    explicit Generator( const GeneratorOptions& options );
+
+    void write( std::ostream& stream );
+    template <typename Sink> void generate( Sink& sink ) const;
+
+    Generator( const Generator& ) = delete;
+    Generator& operator=( const Generator& ) = delete;
+
+    static bool hasProfile( const std::string& profile );
+    static bool hasBursts( const std::string& bursts );
+
+    static const int CyclesMinimum = 5;
+    static const int CyclesMaximum = 15;
+    static const int CyclesMean = 10;
+    static const int LineLength = 55;
+
+private:
+    enum class Bursts
+    {
+        Uniform,
+        Pareto,
+        Lognormal
+    };
+
+    /**
+     * @brief      The odds of a population of programs, the device odds are in
+     * percent and each output odd is of the outputs left by the one before.
+     */
+    struct Profile
+    {
+        int ProcessingPercent;
+        int InputHardDrive;
+        int OutputHardDrive;
+        int OutputMonitor;
+        int ProcessingScale;
+        int IOScale;
+    };
+
+    /**
+     * @brief      The text of a batch of programs, which is the sink that
+     * formats each program.
+     */
+    struct Batch
+    {
+        void startProgram();
+        void arrive( int gap );
+        void operation( const GeneratedOperation& operation, int cycles );
+        void endProgram();
+
+        std::vector<char> Buffer;
+        size_t Size;
+        size_t LineLength;
+    };
+
+    void writeBatch( Batch& batch, long long first, long long last ) const;
+    template <typename Sink> 
+    void drawProgram( Sink& sink, long long program ) const;
+    const Profile& drawProfile( Random& random ) const;
+    int drawCycles( Random& random, int scale ) const;
+    static void writeOperation( Batch& batch, const char* operation,
+        size_t length, int cycles );
+    static void append( Batch& batch, const char* text, size_t length );
+
+    static const size_t BatchBytes = 1 << 20;
+    static const size_t OperationBytes = 26;
+    static const int BatchesPerThread = 4;
+    static const int CyclesCap = 100;
+
+    static const std::map<std::string, Profile> Profiles;
+    static const GeneratedOperation Run;
+    static const GeneratedOperation HardDriveInput;
+    static const GeneratedOperation KeyboardInput;
+    static const GeneratedOperation HardDriveOutput;
+    static const GeneratedOperation MonitorOutput;
+    static const GeneratedOperation PrinterOutput;
+
+    GeneratorOptions m_options;
+    Bursts m_bursts;
+    Profile m_uniform;
+    const Profile* m_profile;
+};
+
+//
+// DRAWING /////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Draws every program in order into a sink.
+ *
+ * @tparam     Sink  What receives the operations, see Generator.
+ *
+ * @param      sink  The sink.
+ */
+template <typename Sink>
+void Generator::generate( Sink& sink ) const
+{
+    for( long long program = 0; program < m_options.programs; program++ )
+        drawProgram( sink, program );
+}
+
+/**
+ * @brief      Draws one program between its start and its end.
+ * @details    Each operation is processing with the profile's odds, otherwise
+ * the program alternates between input and output, starting with input.
+ *
+ * @tparam     Sink     What receives the operations, see Generator.
+ *
+ * @param      sink     The sink.
+ * @param[in]  program  The index of the program, which seeds its stream.
+ */
+template <typename Sink>
+void Generator::drawProgram( Sink& sink, long long program ) const
+{
+    Random random( Random::hash( m_options.seed, program ) );
+    const Profile& profile = m_profile != nullptr ? *m_profile : 
+        drawProfile( random );
+    bool input = true;
+
+    sink.startProgram();
+    if( m_options.meanArrival > 0 )
+    {
+        // Exponential gaps between arrivals make a Poisson process
+        sink.arrive( static_cast<int>( std::llround(
+            -m_options.meanArrival * std::log( random.fraction() ) ) ) );
+    }
+    for( int operation = 0; operation < m_options.operations; operation++ )
+    {
+        // Draw the operation before its cycles, as the original generator did
+        const GeneratedOperation* drawn;
+        int scale = profile.IOScale;
+        if( static_cast<int>( random.below32( 100 ) ) <
+            profile.ProcessingPercent )
+        {
+            drawn = &Run;
+            scale = profile.ProcessingScale;
+        }
+        else if( input )
+        {
+            drawn = static_cast<int>( random.below32( 100 ) ) <
+                profile.InputHardDrive ? &HardDriveInput : &KeyboardInput;
+            input = false;
+        }
+        else
+        {
+            if( static_cast<int>( random.below32( 100 ) ) <
+                profile.OutputHardDrive )
+            {
+                drawn = &HardDriveOutput;
+            }
+            else if( static_cast<int>( random.below32( 100 ) ) <
+                profile.OutputMonitor )
+            {
+                drawn = &MonitorOutput;
+            }
+            else
+            {
+                drawn = &PrinterOutput;
+            }
+            input = true;
+        }
+
+        sink.operation( *drawn, drawCycles( random, scale ) );
+    }
+    sink.endProgram();
+}
+
+#endif  //  GENERATOR_H
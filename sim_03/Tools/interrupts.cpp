@@ -0,0 +1,239 @@
+#include "interrupts.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    // The epoll tag of the timer that bounds wait(), every other tag is the
+    // index of a completion timer
+    const uint64_t DeadlineTag = UINT64_MAX;
+
+    /**
+     * @brief      Converts a duration to the timespec timerfd expects.
+     *
+     * @param[in]  duration  The duration.
+     *
+     * @return     The same duration in seconds and nanoseconds.
+     */
+    timespec toTimespec( std::chrono::nanoseconds duration )
+    {
+        timespec value;
+        value.tv_sec = duration.count() / 1000000000;
+        value.tv_nsec = duration.count() % 1000000000;
+        return value;
+    }
+
+    /**
+     * @brief      Creates a one-shot monotonic timerfd and watches it.
+     *
+     * @param[in]  epoll  The epoll instance.
+     * @param[in]  tag    The tag the epoll instance reports it with.
+     *
+     * @return     The file descriptor of the timer.
+     */
+    int createTimer( int epoll, uint64_t tag )
+    {
+        int timer = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK |
+            TFD_CLOEXEC );
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u64 = tag;
+
+        if( timer < 0 || epoll_ctl( epoll, EPOLL_CTL_ADD, timer, &event ) < 0 )
+        {
+            std::cout << "WARNING: Interrupt timer could not be created."
+                << std::endl;
+            exit( EXIT_FAILURE );
+        }
+        return timer;
+    }
+}
+#endif
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor, no completion is pending.
+ */
+Interrupts::Interrupts()
+    :   m_pending( 0 )
+{
+#ifdef __linux__
+    m_epoll = epoll_create1( EPOLL_CLOEXEC );
+    if( m_epoll < 0 )
+    {
+        std::cout << "WARNING: Interrupt loop could not be created."
+            << std::endl;
+        exit( EXIT_FAILURE );
+    }
+    m_deadline = createTimer( m_epoll, DeadlineTag );
+#endif
+}
+
+/**
+ * @brief      Closes every timer, pending completions are dropped.
+ */
+Interrupts::~Interrupts()
+{
+#ifdef __linux__
+    for( size_t timer = 0; timer < m_timers.size(); timer++ )
+        close( m_timers[ timer ] );
+    close( m_deadline );
+    close( m_epoll );
+#endif
+}
+
+//
+// TIMERS //////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Schedules a completion.
+ *
+ * @param[in]  delay   The time in microseconds until the completion.
+ * @param[in]  source  The value wait() reports the completion with.
+ */
+void Interrupts::arm( long long delay, int source )
+{
+    m_pending++;
+#ifdef __linux__
+    int slot;
+    if( m_free.empty() )
+    {
+        slot = m_sources.size();
+        m_sources.push_back( source );
+        m_timers.push_back( createTimer( m_epoll, slot ) );
+    }
+    else
+    {
+        slot = m_free.back();
+        m_free.pop_back();
+        m_sources[ slot ] = source;
+    }
+
+    // A zero expiry disarms a timerfd, so the shortest delay is 1 ns
+    itimerspec expiry = {};
+    expiry.it_value = toTimespec( std::max( std::chrono::nanoseconds( 1 ),
+        std::chrono::nanoseconds( std::chrono::microseconds( delay ) ) ) );
+    timerfd_settime( m_timers[ slot ], 0, &expiry, nullptr );
+#else
+    m_deadlines.insert( std::make_pair( Clock::now() +
+        std::chrono::microseconds( delay ), source ) );
+#endif
+}
+
+/**
+ * @brief      Waits until the deadline or until at least one completion
+ * fires, whichever is first.
+ *
+ * @param[in]  deadline  The latest time to return at.
+ * @param      fired     Receives the source of every completion that fired.
+ */
+void Interrupts::wait( Clock::time_point deadline, std::vector<int>& fired )
+{
+#ifdef __linux__
+    itimerspec expiry = {};
+    expiry.it_value = toTimespec( std::max( std::chrono::nanoseconds( 1 ),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        deadline.time_since_epoch() ) ) );
+    timerfd_settime( m_deadline, TFD_TIMER_ABSTIME, &expiry, nullptr );
+
+    size_t before = fired.size();
+    while( fired.size() == before && Clock::now() < deadline )
+        poll( -1, fired );
+
+    expiry = itimerspec();
+    timerfd_settime( m_deadline, 0, &expiry, nullptr );
+#else
+    if( !( m_deadlines.empty() ) && m_deadlines.begin()->first < deadline )
+        deadline = m_deadlines.begin()->first;
+    std::this_thread::sleep_until( deadline );
+    poll( 0, fired );
+#endif
+}
+
+/**
+ * @brief      Waits until at least one completion fires, at least one must be
+ * pending.
+ *
+ * @param      fired  Receives the source of every completion that fired.
+ */
+void Interrupts::waitAny( std::vector<int>& fired )
+{
+    size_t before = fired.size();
+    while( fired.size() == before && m_pending > 0 )
+    {
+#ifdef __linux__
+        poll( -1, fired );
+#else
+        std::this_thread::sleep_until( m_deadlines.begin()->first );
+        poll( 0, fired );
+#endif
+    }
+}
+
+/**
+ * @brief      The number of completions that have not fired yet.
+ *
+ * @return     The pending completions.
+ */
+int Interrupts::pending() const
+{
+    return m_pending;
+}
+
+//
+// HELPER FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Collects the completions that have fired.
+ *
+ * @param[in]  timeout  The longest time in ms to wait for one, -1 waits until
+ * any timer fires.
+ * @param      fired    Receives the source of every completion that fired.
+ */
+void Interrupts::poll( int timeout, std::vector<int>& fired )
+{
+#ifdef __linux__
+    epoll_event events[ 64 ];
+    int count = epoll_wait( m_epoll, events, 64, timeout );
+
+    for( int index = 0; index < count; index++ )
+    {
+        uint64_t tag = events[ index ].data.u64;
+        uint64_t expirations;
+        int timer = tag == DeadlineTag ? m_deadline : m_timers[ tag ];
+        if( read( timer, &expirations, sizeof( expirations ) ) < 0 )
+            continue;
+
+        if( tag != DeadlineTag )
+        {
+            fired.push_back( m_sources[ tag ] );
+            m_free.push_back( tag );
+            m_pending--;
+        }
+    }
+#else
+    ( void )timeout;
+    Clock::time_point now = Clock::now();
+    while( !( m_deadlines.empty() ) && m_deadlines.begin()->first <= now )
+    {
+        fired.push_back( m_deadlines.begin()->second );
+        m_deadlines.erase( m_deadlines.begin() );
+        m_pending--;
+    }
+#endif
+}
@@ -0,0 +1,48 @@
+#ifndef INTERRUPTS_H
+#define INTERRUPTS_H
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+/**
+ * @brief      Delivers timed completions like hardware interrupts, every
+ * pending completion is a one-shot timer and a single loop waits for all of
+ * them at once.
+ * @details    On Linux each timer is a timerfd watched by one epoll instance,
+ * timerfds are reused once they fire so a completion costs no thread and no
+ * new descriptor. Elsewhere the timers are kept in order of deadline and
+ * waited for with the standard library.
+ */
+class Interrupts
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    Interrupts();
+    ~Interrupts();
+
+    void arm( long long delay, int source );
+    void wait( Clock::time_point deadline, std::vector<int>& fired );
+    void waitAny( std::vector<int>& fired );
+    int pending() const;
+
+    Interrupts( const Interrupts& ) = delete;
+    Interrupts& operator=( const Interrupts& ) = delete;
+
+private:
+    void poll( int timeout, std::vector<int>& fired );
+
+    int m_pending;
+#ifdef __linux__
+    int m_epoll;
+    int m_deadline;
+    std::vector<int> m_timers;
+    std::vector<int> m_sources;
+    std::vector<int> m_free;
+#else
+    std::multimap<Clock::time_point, int> m_deadlines;
+#endif
+};
+
+#endif  //  INTERRUPTS_H
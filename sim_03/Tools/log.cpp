@@ -1,5 +1,7 @@
 #include "log.h"
 
+#include <cstring>
+
 //Static configs for output file
 Config Log::m_config;
 std::ofstream Log::m_file;
@@ -58,17 +60,29 @@ void Log::closeFile()
  * @param[in] val  The value of the string to log.
  * @return    A reference to this Log so that outputs may be concatenated.
  */
-Log& Log::operator<<( std::string val )
+Log& Log::operator<<( const std::string& val )
+{
+    return *this << val.c_str();
+}
+
+/**
+ * @brief     Outputs a string literal to the selected logger configuration,
+ * without copying it into a std::string first.
+ * 
+ * @param[in] val  The string to log.
+ * @return    A reference to this Log so that outputs may be concatenated.
+ */
+Log& Log::operator<<( const char* val )
 {
     //Log to both console and file
     if( m_config.log == "Log to Both" )
     {
         //Set output colors for specific keywords
-        if( val == "START" )
+        if( std::strcmp( val, "START" ) == 0 )
             std::cout << COLOR_GREEN_BLACK << val << COLOR_NORMAL;
-        else if( val == "SELECTING" )
+        else if( std::strcmp( val, "SELECTING" ) == 0 )
              std::cout << COLOR_YELLOW_BLACK << val << COLOR_NORMAL;
-        else if( val == "END" )
+        else if( std::strcmp( val, "END" ) == 0 )
             std::cout << COLOR_RED_BLACK << val << COLOR_NORMAL;
         //Write all other strings to cout
         else
@@ -81,11 +95,11 @@ Log& Log::operator<<( std::string val )
     else if( m_config.log == "Log to Monitor" )
     {
         //Set output colors for specific keywords
-        if( val == "START" )
+        if( std::strcmp( val, "START" ) == 0 )
             std::cout << COLOR_GREEN_BLACK << val << COLOR_NORMAL;
-        else if( val == "SELECTING" )
+        else if( std::strcmp( val, "SELECTING" ) == 0 )
             std::cout << COLOR_YELLOW_BLACK << val << COLOR_NORMAL;
-        else if( val == "END" )
+        else if( std::strcmp( val, "END" ) == 0 )
             std::cout << COLOR_RED_BLACK << val << COLOR_NORMAL;
         //Non-specific keyword, just write
         else
@@ -20,7 +20,8 @@ public:
 
     static void closeFile();
 
-    Log& operator<<( std::string val );
+    Log& operator<<( const std::string& val );
+    Log& operator<<( const char* val );
     Log& operator<<( float val );
     Log& operator<<( int val );
 
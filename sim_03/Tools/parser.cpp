@@ -1,5 +1,10 @@
 #include "parser.h"
 
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <set>
+
 //
 // LOAD FILES //////////////////////////////////////////////////////////////////
 //
@@ -20,9 +25,10 @@ std::string Parser::loadData( std::string path )
     read.open( path.c_str() );
     if( read.is_open() )
     {
-        // Push characters into the string
-        while( !read.eof() )
-            temp += read.get();
+        // Push characters into the string, stopping before the end of file
+        char character;
+        while( read.get( character ) )
+            temp += character;
     }
     else
     {
@@ -34,74 +40,361 @@ std::string Parser::loadData( std::string path )
     return temp;
 }
 
+//
+// CONFIG KEYS /////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      The lines every config must give.
+ */
+const std::vector<std::string> Parser::RequiredKeys = {
+    "Version/Phase", "File Path", "CPU Scheduling Code", 
+    "Quantum Time (cycles)", "Processor cycle time (msec)", 
+    "Monitor display time (msec)", "Hard drive cycle time (msec)", 
+    "Printer cycle time (msec)", "Keyboard cycle time (msec)", "Log", 
+    "Log File Path"
+};
+
+/**
+ * @brief      Every whole number setting and its range.
+ * @details    "Processor count" and "Thread count" are other names for
+ * "Processors" and "Host threads".
+ */
+const std::map<std::string, Parser::IntegerKey> Parser::IntegerKeys = {
+    { "Quantum Time (cycles)", { &Config::quantumTime, 1, Unbounded } },
+    { "Processor cycle time (msec)", 
+        { &Config::processorCycle, 1, Unbounded } },
+    { "Monitor display time (msec)", 
+        { &Config::monitorDisplayCycle, 0, Unbounded } },
+    { "Hard drive cycle time (msec)", 
+        { &Config::hardDriveCycle, 0, Unbounded } },
+    { "Printer cycle time (msec)", { &Config::printerCycle, 0, Unbounded } },
+    { "Keyboard cycle time (msec)", { &Config::keyboardCycle, 0, Unbounded } },
+    { "Target latency (cycles)", { &Config::targetLatency, 1, Unbounded } },
+    { "Minimum granularity (cycles)", 
+        { &Config::minimumGranularity, 1, Unbounded } },
+    { "Feedback boost period (cycles)", 
+        { &Config::feedbackBoostPeriod, 0, Unbounded } },
+    { "Default tickets", { &Config::defaultTickets, 1, Unbounded } },
+    { "Processors", { &Config::processors, 1, 4096 } },
+    { "Processor count", { &Config::processors, 1, 4096 } },
+    { "Migration cost (cycles)", { &Config::migrationCost, 0, Unbounded } },
+    { "Host threads", { &Config::hostThreads, 1, 256 } },
+    { "Thread count", { &Config::hostThreads, 1, 256 } },
+    { "Cache warm-up (cycles)", { &Config::cacheWarmup, 0, Unbounded } },
+    { "Cache decay (msec)", { &Config::cacheDecay, 1, Unbounded } },
+    { "Hard drives", { &Config::hardDrives, 1, 1024 } },
+    { "Keyboards", { &Config::keyboards, 1, 1024 } },
+    { "Monitors", { &Config::monitors, 1, 1024 } },
+    { "Printers", { &Config::printers, 1, 1024 } },
+    { "Device sample period (msec)", 
+        { &Config::deviceSamplePeriod, 0, Unbounded } },
+    { "Cylinders", { &Config::cylinders, 0, Unbounded } },
+    { "Seek time (usec per cylinder)", { &Config::seekTime, 0, Unbounded } },
+    { "Rotational latency (msec)", 
+        { &Config::rotationalLatency, 0, Unbounded } },
+    { "Buffer cache blocks", { &Config::bufferCacheBlocks, 0, Unbounded } },
+    { "Buffer cache hit time (msec)", 
+        { &Config::bufferCacheHitTime, 0, Unbounded } },
+    { "Disk blocks", { &Config::diskBlocks, 1, Unbounded } },
+    { "Monitor spool (requests)", { &Config::monitorSpool, 0, Unbounded } },
+    { "Printer spool (requests)", { &Config::printerSpool, 0, Unbounded } },
+    { "Hard drive setup (msec)", { &Config::hardDriveSetup, 0, Unbounded } },
+    { "Keyboard setup (msec)", { &Config::keyboardSetup, 0, Unbounded } },
+    { "Monitor setup (msec)", { &Config::monitorSetup, 0, Unbounded } },
+    { "Printer setup (msec)", { &Config::printerSetup, 0, Unbounded } }
+};
+
+/**
+ * @brief      Every text setting and the values it may take, any text if none
+ * are listed.
+ * @details    The scheduling codes are those of Simulator::Schedulers.
+ */
+const std::map<std::string, Parser::TextKey> Parser::TextKeys = {
+    { "Version/Phase", { &Config::version, {} } },
+    { "File Path", { &Config::filePath, {} } },
+    { "CPU Scheduling Code", { &Config::schedulingCode, 
+        { "RR", "FIFO-P", "SRTF-P", "CFS", "MLFQ", "LOTTERY", "STRIDE" } } },
+    { "Log", { &Config::log, 
+        { "Log to Both", "Log to Monitor", "Log to File" } } },
+    { "Log File Path", { &Config::logFilePath, {} } },
+    { "Placement", { &Config::placement, { "Balance", "Affinity" } } },
+    { "Synchronization", { &Config::synchronization, 
+        { "Windows", "Sequential" } } },
+    { "Disk scheduling", { &Config::diskScheduling, 
+        { "FCFS", "SSTF", "SCAN", "C-LOOK" } } },
+    { "Buffer cache replacement", { &Config::bufferCacheReplacement, 
+        { "LRU", "CLOCK" } } },
+    { "I/O completion", { &Config::ioCompletion, 
+        { "Blocking", "Interrupt" } } },
+    { "Time mode", { &Config::timeMode, { "Real", "Simulated" } } },
+    { "Log level", { &Config::logLevel, { "Events", "Summary" } } }
+};
+
 //
 // PARSING FUNCTIONS ///////////////////////////////////////////////////////////
 //
 
 /**
  * @brief      Parses string data into a Config.
+ * @details    Every line is a "Key: value" pair that may be given in any order,
+ * the "Start" and "End" lines and blank lines are skipped. Unknown keys are
+ * reported and ignored. A missing required key, a key given more than once or
+ * a value out of its range is reported and makes the config invalid.
  *
  * @param[in]  data    String data that was loaded from a .cnf file.
  * @param      config  The Config to load the data into.
+ *
+ * @return     True if the config is valid, false otherwise.
+ */
+bool Parser::parseConfig( const std::string& data, Config& config )
+{
+    std::istringstream stream( data );
+    std::string line;
+    std::set<std::string> seen;
+    bool valid = true;
+
+    while( std::getline( stream, line ) )
+    {
+        line.erase( line.find_last_not_of( " \t\r" ) + 1 );
+        if( line.empty() || line.compare( 0, 6, "Start " ) == 0 ||
+            line.compare( 0, 4, "End " ) == 0 )
+        {
+            continue;
+        }
+
+        size_t keyPos = line.find( ':' );
+        if( keyPos == std::string::npos )
+        {
+            std::cout << "WARNING: Config line \"" << line 
+                << "\" is not a \"Key: value\" pair and is ignored." 
+                << std::endl;
+            continue;
+        }
+
+        std::string key = line.substr( 0, keyPos );
+        std::string value = line.substr( std::min( 
+            line.find_first_not_of( ' ', keyPos + 1 ), line.size() ) );
+
+        // "Processor count" and "Thread count" give the same settings as
+        // "Processors" and "Host threads", so only one of each may be given
+        std::string setting = key == "Processor count" ? "Processors" :
+            key == "Thread count" ? "Host threads" : key;
+        if( !( seen.insert( setting ).second ) )
+        {
+            std::cout << "WARNING: Config key \"" << setting 
+                << "\" is given more than once." << std::endl;
+            valid = false;
+            continue;
+        }
+
+        if( !( parseSetting( key, value, config, valid ) ) )
+        {
+            std::cout << "WARNING: Unknown config key \"" << key 
+                << "\" is ignored." << std::endl;
+        }
+    }
+
+    for( size_t index = 0; index < RequiredKeys.size(); index++ )
+    {
+        if( seen.count( RequiredKeys[ index ] ) == 0 )
+        {
+            std::cout << "WARNING: Config is missing \"" 
+                << RequiredKeys[ index ] << "\"." << std::endl;
+            valid = false;
+        }
+    }
+
+    // Several processors have always implied the simulation's own clock
+    if( seen.count( "Time mode" ) == 0 && config.processors > 1 )
+        config.timeMode = "Simulated";
+    else if( config.timeMode == "Real" && config.processors > 1 )
+    {
+        std::cout << "WARNING: Config \"Time mode: Real\" only simulates one "
+            << "processor, use \"Time mode: Simulated\"." << std::endl;
+        valid = false;
+    }
+
+    return valid;
+}
+
+/**
+ * @brief      Parses one config setting by its key.
+ *
+ * @param[in]  key     The key, such as "Quantum Time (cycles)".
+ * @param[in]  value   The value as written.
+ * @param      config  The Config to load the value into.
+ * @param[out] valid   Set to false if the value is out of its range, left
+ * unchanged otherwise.
+ *
+ * @return     True if the key is known, false otherwise.
+ */
+bool Parser::parseSetting( const std::string& key, const std::string& value,
+    Config& config, bool& valid )
+{
+    long long number = 0;
+
+    std::map<std::string, IntegerKey>::const_iterator integer = 
+        IntegerKeys.find( key );
+    if( integer != IntegerKeys.end() )
+    {
+        if( toInteger( value, number ) && 
+            number >= integer->second.Minimum && 
+            number <= integer->second.Maximum )
+        {
+            config.*( integer->second.Field ) = static_cast<int>( number );
+        }
+        else
+        {
+            std::cout << "WARNING: Config \"" << key 
+                << "\" must be a whole number from " << integer->second.Minimum
+                << " to " << integer->second.Maximum << ", not \"" << value 
+                << "\"." << std::endl;
+            valid = false;
+        }
+        return true;
+    }
+
+    std::map<std::string, TextKey>::const_iterator text = TextKeys.find( key );
+    if( text != TextKeys.end() )
+    {
+        const std::vector<std::string>& choices = text->second.Choices;
+        if( choices.empty() || 
+            std::find( choices.begin(), choices.end(), value ) != 
+            choices.end() )
+        {
+            config.*( text->second.Field ) = value;
+        }
+        else
+        {
+            std::cout << "WARNING: Config \"" << key << "\" must be one of";
+            for( size_t index = 0; index < choices.size(); index++ )
+                std::cout << ( index > 0 ? ", \"" : " \"" ) 
+                    << choices[ index ] << "\"";
+            std::cout << ", not \"" << value << "\"." << std::endl;
+            valid = false;
+        }
+        return true;
+    }
+
+    if( key == "Feedback quanta (cycles)" )
+    {
+        std::vector<int> quanta = splitIntegers( value );
+        if( !( quanta.empty() ) && 
+            *std::min_element( quanta.begin(), quanta.end() ) >= 1 )
+        {
+            config.feedbackQuanta = quanta;
+        }
+        else
+        {
+            std::cout << "WARNING: Config \"" << key << "\" must list one or "
+                << "more positive quanta, not \"" << value << "\"." 
+                << std::endl;
+            valid = false;
+        }
+    }
+    else if( key == "Random seed" )
+    {
+        if( toInteger( value, number ) && number >= 0 )
+            config.randomSeed = static_cast<unsigned long long>( number );
+        else
+        {
+            std::cout << "WARNING: Config \"" << key << "\" must be a whole "
+                << "number from 0, not \"" << value << "\"." << std::endl;
+            valid = false;
+        }
+    }
+    else if( key == "Time scale" )
+    {
+        char* end = nullptr;
+        float scale = std::strtof( value.c_str(), &end );
+        if( !( value.empty() ) && *end == '\0' && scale > 0.0f && 
+            scale <= 1000.0f )
+        {
+            config.timeScale = scale;
+        }
+        else
+        {
+            std::cout << "WARNING: Config \"" << key << "\" must be above 0 "
+                << "and at most 1000, not \"" << value << "\"." << std::endl;
+            valid = false;
+        }
+    }
+    else if( key == "Coalesce devices" )
+    {
+        config.coalescedDevices = splitNames( value );
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Converts text to a whole number, the whole text must be the
+ * number.
+ *
+ * @param[in]  text   The text, such as "-12".
+ * @param[out] value  The number.
+ *
+ * @return     True if the text is a whole number, false otherwise.
  */
-void Parser::parseConfig( std::string data, Config& config )
+bool Parser::toInteger( const std::string& text, long long& value )
 {
-    //Remove useless first line
-    data.erase( 0, data.find( '\n' ) + 1 );
-
-    for( int lineNumber = 0; lineNumber < 11; lineNumber++ )
-    {
-        size_t frontPos = data.find( ": " ) + 2;
-        size_t backPos = data.find( '\n' );
-
-        switch( lineNumber )
-        {
-            case 0:
-                config.version = data.substr( frontPos, backPos - frontPos );
-                break;
-            case 1:
-                config.filePath = data.substr( frontPos, backPos - frontPos );
-                break;
-            case 2:
-                config.schedulingCode = 
-                    data.substr( frontPos, backPos - frontPos );
-                break;
-            case 3:
-                config.quantumTime = std::stoi( 
-                    data.substr( frontPos, backPos - frontPos ));
-            case 4:
-                config.processorCycle = std::stoi( 
-                    data.substr( frontPos, backPos - frontPos ));
-                break;
-            case 5:
-                config.monitorDisplayCycle = std::stoi( 
-                    data.substr( frontPos, backPos - frontPos ));
-                break;
-            case 6:
-                config.hardDriveCycle = std::stoi( 
-                    data.substr( frontPos, backPos - frontPos ));
-                break;
-            case 7:
-                config.printerCycle = std::stoi( 
-                    data.substr( frontPos, backPos - frontPos ));
-                break;
-            case 8:
-                config.keyboardCycle = std::stoi( 
-                    data.substr( frontPos, backPos - frontPos ));
-                break;
-            case 9:
-                config.log = data.substr( frontPos, backPos - frontPos );
-                break;
-            case 10:
-                config.logFilePath = 
-                    data.substr( frontPos, backPos - frontPos );
-                break;
-            default:
-                break;
-        }
-
-        data.erase( 0, backPos + 1 );
+    if( text.empty() )
+        return false;
+
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoll( text.c_str(), &end, 10 );
+    return *end == '\0' && errno == 0;
+}
+
+/**
+ * @brief      Splits a whitespace separated list of integers.
+ *
+ * @param[in]  data  The integers to split, such as "3 6 12".
+ *
+ * @return     Every integer within the data in order.
+ */
+std::vector<int> Parser::splitIntegers( std::string data )
+{
+    std::vector<int> values;
+    std::istringstream stream( data );
+    int value;
+
+    while( stream >> value )
+        values.push_back( value );
+
+    return values;
+}
+
+/**
+ * @brief      Splits a comma separated list of names, such as
+ * "hard drive, printer".
+ *
+ * @param[in]  data  The names separated by commas.
+ *
+ * @return     Each name without surrounding spaces, in order.
+ */
+std::vector<std::string> Parser::splitNames( std::string data )
+{
+    std::vector<std::string> names;
+    std::istringstream stream( data );
+    std::string name;
+
+    while( std::getline( stream, name, ',' ) )
+    {
+        size_t frontPos = name.find_first_not_of( ' ' );
+        if( frontPos == std::string::npos )
+            continue;
+        names.push_back( name.substr( frontPos,
+            name.find_last_not_of( ' ' ) - frontPos + 1 ) );
     }
+
+    return names;
 }
 
 /**
@@ -117,67 +410,122 @@ std::list<std::string> Parser::splitMetaData( std::string metadata )
 {
     // Remove the first line (contains "Start Program Meta-Data Code:")
     metadata.erase( 0, metadata.find( '\n' ) + 1 );
-    // Remove all new line characters
-    metadata.erase( 
-        std::remove( metadata.begin(), metadata.end(), '\n' ), metadata.end() );
+    // The last operation ends with "." instead of a ";"
+    size_t end = std::min( metadata.find( '.' ), metadata.size() );
 
-    size_t pos = 0;
-    std::string token;
+    const char* space = " \t\r\n";
+    size_t start = 0;
     std::list<std::string> tokens;
-    std::string delimiter = "; ";
-    // Grab all the operations ending with ";"
-    while( ( pos = metadata.find( delimiter ) ) != std::string::npos )
-    {
-        // Extract the operation
-        token = metadata.substr( 0, pos );
-        // Push it into the vector
-        tokens.push_back( token );
-        //Remove the operation
-        metadata.erase( 0, pos + delimiter.length() );
-    }
-    // Grab the last operation that ends with "." instead of a ";"
-    pos = metadata.find( "." );
-    token = metadata.substr( 0, pos );
-    tokens.push_back( token );
+    // Operations are separated by ";" and any spaces or line breaks, the
+    // metadata is scanned in place rather than erased from the front
+    while( start < end )
+    {
+        size_t pos = std::min( metadata.find( ';', start ), end );
+        size_t first = metadata.find_first_not_of( space, start );
+        if( first < pos )
+        {
+            size_t last = metadata.find_last_not_of( space, pos - 1 );
+            tokens.push_back( metadata.substr( first, last + 1 - first ) );
+        }
+        start = pos + 1;
+    }
 
     return tokens;
 }
 
 /**
- * @brief       Splits a single operation into a map.
+ * @brief       Parses a single operation without copying any of it.
  * details      The operation must take the form: 
  * "COMPONENT_LETTER(OPERATION)CYCLE_TIME". An example is "I(hard drive)10".
  *
- * @param[in]  data   An operation in the proper format.
+ * @param[in]  operation  An operation.
+ * @param[out] record     The parsed operation, or the reason the operation is
+ * malformed in its Error.
  *
- * @return     A map containing the keys "Component", "Operation", "Cycle".
+ * @return     True if the operation is in the proper format, false otherwise.
  */
-std::map<std::string, std::string> Parser::splitOperation( 
-    std::string operation )
+bool Parser::parseOperation( const std::string& operation, 
+    OperationRecord& record )
 {
-    std::map<std::string, std::string> operationMap;
-    std::string token;
-    std::string delimiter = ")";
-    
-    size_t pos = 0;
+    record = OperationRecord{ '\0', 0, 0, 0, nullptr };
 
     // <Component Letter>(<Operation>)<Cycle Time>
     // Get component letter
-    pos = 1;
-    token = operation.substr( 0, pos );
-    operationMap["Component"] = token;
-    operation.erase( 0, pos + 1 );
+    if( operation.size() < 2 || operation[ 1 ] != '(' )
+    {
+        record.Error = "expected a component letter followed by \"(\"";
+        return false;
+    }
+    record.Component = operation[ 0 ];
+    if( std::string( "SAPIO" ).find( record.Component ) == std::string::npos )
+    {
+        record.Error = "unknown component letter";
+        return false;
+    }
 
     // <Operation>)<Cycle Time>
     // Get operation
-    pos = operation.find( delimiter );
-    token = operation.substr( 0, pos );
-    operationMap["Operation"] = token;
-    operation.erase( 0, pos + delimiter.length() );
+    size_t close = operation.find( ')', 2 );
+    if( close == std::string::npos )
+    {
+        record.Error = "missing \")\"";
+        return false;
+    }
+    record.NameStart = 2;
+    record.NameLength = close - 2;
 
     // <Cycle Time>
     // Get cycle time
-    operationMap["Cycle"] = operation;
+    if( close + 1 == operation.size() )
+    {
+        record.Error = "missing cycle count";
+        return false;
+    }
+    long long cycles = 0;
+    for( size_t pos = close + 1; pos < operation.size(); pos++ )
+    {
+        if( operation[ pos ] < '0' || operation[ pos ] > '9' )
+        {
+            record.Error = "cycle count is not a number";
+            return false;
+        }
+        cycles = cycles * 10 + ( operation[ pos ] - '0' );
+        if( cycles > std::numeric_limits<int>::max() )
+        {
+            record.Error = "cycle count is too large";
+            return false;
+        }
+    }
+    record.Cycles = static_cast<int>( cycles );
 
-    return operationMap;
-}
\ No newline at end of file
+    return true;
+}
+
+/**
+ * @brief      Whether a parsed operation has a given name.
+ *
+ * @param[in]  operation  The operation that was parsed.
+ * @param[in]  record     The operation's record.
+ * @param[in]  name       The name to compare with, such as "start".
+ *
+ * @return     True if the names are equal, false otherwise.
+ */
+bool Parser::isNamed( const std::string& operation, 
+    const OperationRecord& record, const char* name )
+{
+    return operation.compare( record.NameStart, record.NameLength, name ) == 0;
+}
+
+/**
+ * @brief      Copies the name out of a parsed operation.
+ *
+ * @param[in]  operation  The operation that was parsed.
+ * @param[in]  record     The operation's record.
+ *
+ * @return     The name, such as "hard drive".
+ */
+std::string Parser::nameOf( const std::string& operation, 
+    const OperationRecord& record )
+{
+    return operation.substr( record.NameStart, record.NameLength );
+}
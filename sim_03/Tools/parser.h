@@ -3,18 +3,70 @@
 
 #include <iostream>
 #include <fstream>
+#include <limits>
 #include <list>
 #include <map>
+#include <sstream>
+#include <vector>
 #include <algorithm>
 
 #include "config.h"
 
+/**
+ * @brief      One meta-data operation, such as "I(hard drive)10", as parsed by
+ * Parser::parseOperation().
+ * @details    The name is not copied out of the operation, it is the
+ * NameLength characters at NameStart of the text that was parsed.
+ */
+struct OperationRecord
+{
+    char Component;
+    size_t NameStart;
+    size_t NameLength;
+    int Cycles;
+    const char* Error;
+};
+
 namespace Parser
 {
+    /**
+     * @brief      A whole number setting of the Config and its range.
+     */
+    struct IntegerKey
+    {
+        int Config::* Field;
+        int Minimum;
+        int Maximum;
+    };
+
+    /**
+     * @brief      A text setting of the Config and the values it may take.
+     */
+    struct TextKey
+    {
+        std::string Config::* Field;
+        std::vector<std::string> Choices;
+    };
+
+    const int Unbounded = std::numeric_limits<int>::max();
+    extern const std::vector<std::string> RequiredKeys;
+    extern const std::map<std::string, IntegerKey> IntegerKeys;
+    extern const std::map<std::string, TextKey> TextKeys;
+
     std::string loadData( std::string path );
-    void parseConfig( std::string data, Config& config );
+    bool parseConfig( const std::string& data, Config& config );
+    bool parseSetting( const std::string& key, const std::string& value,
+        Config& config, bool& valid );
+    bool toInteger( const std::string& text, long long& value );
+    std::vector<int> splitIntegers( std::string data );
+    std::vector<std::string> splitNames( std::string data );
     std::list<std::string> splitMetaData( std::string metadata );
-    std::map<std::string, std::string> splitOperation( std::string operation );
+    bool parseOperation( const std::string& operation, 
+        OperationRecord& record );
+    bool isNamed( const std::string& operation, const OperationRecord& record,
+        const char* name );
+    std::string nameOf( const std::string& operation, 
+        const OperationRecord& record );
 }
 
 #endif  //  PARSER_H
\ No newline at end of file
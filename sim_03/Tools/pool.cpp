@@ -0,0 +1,131 @@
+#include "pool.h"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace
+{
+    const int Classes = 9;
+    const size_t SmallestBlock = 16;
+    const size_t ChunkBytes = 64 * 1024;
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    /**
+     * @brief      The free list and the chunks of one block size.
+     */
+    struct SizeClass
+    {
+        SizeClass()
+            :   Free( nullptr )
+        {
+        }
+
+        ~SizeClass()
+        {
+            for( size_t chunk = 0; chunk < Chunks.size(); chunk++ )
+                ::operator delete( Chunks[ chunk ] );
+        }
+
+        std::mutex Lock;
+        FreeBlock* Free;
+        std::vector<void*> Chunks;
+    };
+
+    /**
+     * @brief      Every block size, created on first use.
+     *
+     * @return     The size classes, smallest first.
+     */
+    SizeClass* sizeClasses()
+    {
+        static SizeClass classes[ Classes ];
+        return classes;
+    }
+
+    /**
+     * @brief      The size class a request is served from.
+     *
+     * @param[in]  bytes  The bytes requested.
+     *
+     * @return     The index of the smallest block that fits, or Classes if
+     * the request is larger than every block.
+     */
+    int classOf( size_t bytes )
+    {
+        int sizeClass = 0;
+        size_t block = SmallestBlock;
+        while( sizeClass < Classes && block < bytes )
+        {
+            block *= 2;
+            sizeClass++;
+        }
+        return sizeClass;
+    }
+}
+
+//
+// STATIC FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Takes a block for a request.
+ *
+ * @param[in]  bytes  The bytes requested.
+ *
+ * @return     A block of at least that many bytes.
+ */
+void* Pool::allocate( size_t bytes )
+{
+    int sizeClass = classOf( bytes );
+    if( sizeClass == Classes )
+        return ::operator new( bytes );
+
+    SizeClass& pool = sizeClasses()[ sizeClass ];
+    std::lock_guard<std::mutex> guard( pool.Lock );
+
+    // Carve a new chunk into blocks once every block is in use
+    if( pool.Free == nullptr )
+    {
+        size_t block = SmallestBlock << sizeClass;
+        char* chunk = static_cast<char*>( ::operator new( ChunkBytes ) );
+        pool.Chunks.push_back( chunk );
+        for( size_t offset = 0; offset + block <= ChunkBytes; offset += block )
+        {
+            FreeBlock* free = reinterpret_cast<FreeBlock*>( chunk + offset );
+            free->Next = pool.Free;
+            pool.Free = free;
+        }
+    }
+
+    FreeBlock* taken = pool.Free;
+    pool.Free = taken->Next;
+    return taken;
+}
+
+/**
+ * @brief      Returns a block to its free list.
+ *
+ * @param      block  The block, from allocate().
+ * @param[in]  bytes  The bytes it was requested with.
+ */
+void Pool::release( void* block, size_t bytes )
+{
+    int sizeClass = classOf( bytes );
+    if( sizeClass == Classes )
+    {
+        ::operator delete( block );
+        return;
+    }
+
+    SizeClass& pool = sizeClasses()[ sizeClass ];
+    std::lock_guard<std::mutex> guard( pool.Lock );
+
+    FreeBlock* free = static_cast<FreeBlock*>( block );
+    free->Next = pool.Free;
+    pool.Free = free;
+}
@@ -0,0 +1,68 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <cstddef>
+
+/**
+ * @brief      Free lists of recycled memory blocks, shared by every container
+ * whose nodes come and go while the simulation runs.
+ * @details    A request is rounded up to one of the block sizes, 16 bytes to
+ * 4 KB in powers of two, and served from that size's free list. Blocks are
+ * carved from 64 KB chunks and never returned to the heap until the program
+ * ends, so once a queue has reached its largest size it is served without
+ * the heap at all. Larger requests go straight to the heap. Each block size
+ * has its own lock, since containers are used from every host thread.
+ */
+class Pool
+{
+public:
+    static void* allocate( size_t bytes );
+    static void release( void* block, size_t bytes );
+};
+
+/**
+ * @brief      A standard allocator that takes its memory from the Pool, for
+ * node based containers such as std::deque, std::list, std::set and
+ * std::unordered_map.
+ *
+ * @tparam     T     The type allocated.
+ */
+template <typename T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+
+    PoolAllocator()
+    {
+    }
+
+    template <typename U>
+    PoolAllocator( const PoolAllocator<U>& )
+    {
+    }
+
+    T* allocate( size_t count )
+    {
+        return static_cast<T*>( Pool::allocate( count * sizeof( T ) ) );
+    }
+
+    void deallocate( T* block, size_t count )
+    {
+        Pool::release( block, count * sizeof( T ) );
+    }
+};
+
+template <typename T, typename U>
+bool operator==( const PoolAllocator<T>&, const PoolAllocator<U>& )
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=( const PoolAllocator<T>&, const PoolAllocator<U>& )
+{
+    return false;
+}
+
+#endif  //  POOL_H
@@ -0,0 +1,135 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/**
+ * @brief      Seeded pseudo random number generator (xoshiro256**).
+ * @details    The sequence only depends on the seed, so simulations that
+ * draw from it are reproducible on every platform.
+ */
+class Random
+{
+public:
+    /**
+     * @brief      Seeds the generator, the state is expanded from the seed
+     * with SplitMix64 so that nearby seeds produce unrelated sequences.
+     *
+     * @param[in]  seed  The seed of the sequence.
+     */
+    explicit Random( uint64_t seed )
+    {
+        for( int i = 0; i < 4; i++ )
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t value = seed;
+            value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+            value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+            m_state[ i ] = value ^ ( value >> 31 );
+        }
+    }
+
+    /**
+     * @brief      Draws the next 64 random bits.
+     *
+     * @return     A uniformly distributed 64 bit value.
+     */
+    uint64_t next()
+    {
+        uint64_t result = rotate( m_state[ 1 ] * 5, 7 ) * 9;
+        uint64_t shifted = m_state[ 1 ] << 17;
+
+        m_state[ 2 ] ^= m_state[ 0 ];
+        m_state[ 3 ] ^= m_state[ 1 ];
+        m_state[ 1 ] ^= m_state[ 2 ];
+        m_state[ 0 ] ^= m_state[ 3 ];
+        m_state[ 2 ] ^= shifted;
+        m_state[ 3 ] = rotate( m_state[ 3 ], 45 );
+
+        return result;
+    }
+
+    /**
+     * @brief      Draws a value in [0, bound) without modulo bias.
+     *
+     * @param[in]  bound  The exclusive upper bound, must be positive.
+     *
+     * @return     A uniformly distributed value below the bound.
+     */
+    uint64_t below( uint64_t bound )
+    {
+        // Reject the values that would favour the low end of the range
+        uint64_t threshold = ( 0 - bound ) % bound;
+        uint64_t value = next();
+        while( value < threshold )
+            value = next();
+        return value % bound;
+    }
+
+    /**
+     * @brief      Draws a value in [0, bound) without modulo bias, for bounds
+     * that fit in 32 bits.
+     * @details    The value is the high half of a multiply instead of a
+     * remainder, so unlike below() this only divides in the rare case that a
+     * draw must be rejected (Lemire's method).
+     *
+     * @param[in]  bound  The exclusive upper bound, must be positive.
+     *
+     * @return     A uniformly distributed value below the bound.
+     */
+    uint32_t below32( uint32_t bound )
+    {
+        uint64_t product = ( next() >> 32 ) * bound;
+        uint32_t low = static_cast<uint32_t>( product );
+        if( low < bound )
+        {
+            // Reject the values that would favour the low end of the range
+            uint32_t threshold = ( 0 - bound ) % bound;
+            while( low < threshold )
+            {
+                product = ( next() >> 32 ) * bound;
+                low = static_cast<uint32_t>( product );
+            }
+        }
+        return static_cast<uint32_t>( product >> 32 );
+    }
+
+    /**
+     * @brief      Draws a fraction in (0, 1], for drawing from continuous
+     * distributions.
+     *
+     * @return     A uniformly distributed fraction, never 0 so that its
+     * logarithm is finite.
+     */
+    double fraction()
+    {
+        return ( ( next() >> 11 ) + 1 ) * ( 1.0 / 9007199254740992.0 );
+    }
+
+    /**
+     * @brief      Mixes two values into a well distributed 64 bit value, for
+     * values that must be random looking but derived from their inputs.
+     *
+     * @param[in]  first   The first value.
+     * @param[in]  second  The second value.
+     *
+     * @return     The SplitMix64 finalizer of the combined values.
+     */
+    static uint64_t hash( uint64_t first, uint64_t second )
+    {
+        uint64_t value = first * 0x9e3779b97f4a7c15ULL + second;
+        value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+        value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111ebULL;
+        return value ^ ( value >> 31 );
+    }
+
+private:
+    static uint64_t rotate( uint64_t value, int bits )
+    {
+        return ( value << bits ) | ( value >> ( 64 - bits ) );
+    }
+
+    uint64_t m_state[ 4 ];
+};
+
+#endif  //  RANDOM_H
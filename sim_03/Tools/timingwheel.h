@@ -0,0 +1,303 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief      A hierarchical timing wheel, a priority queue of timed values
+ * that is a drop in replacement for the std::priority_queue of events.
+ * @details    The wheel has eight levels of 256 slots. A value is placed on
+ * the level of the highest byte its time differs from the wheel's time in,
+ * so level 0 holds one slot per ms and every higher level is 256 times
+ * coarser. Inserting is a constant time append. Once every lower level is
+ * empty, the earliest slot of a higher level is cascaded into the lower
+ * levels, and every value is cascaded at most seven times.
+ *
+ * Values at the same time leave in the order they were pushed, so T's
+ * operator< must order equal times by insertion, as the simulation's events
+ * do. Times must never be earlier than the last value popped.
+ *
+ * @tparam     T     The value type, with a long long Time and the operator<
+ * std::priority_queue expects, where the top is the greatest value.
+ */
+template <typename T>
+class TimingWheel
+{
+public:
+    TimingWheel();
+
+    void push( const T& value );
+    const T& top() const;
+    void pop();
+    bool empty() const;
+    size_t size() const;
+
+private:
+    static const int Levels = 8;
+    static const int Bits = 8;
+    static const int Slots = 1 << Bits;
+    static const int Words = Slots / 64;
+
+    void place( const T& value );
+    void locate() const;
+    int nextSlot( int level, int from ) const;
+    int slotOf( long long time, int level ) const;
+
+    std::vector<T> m_slots[ Levels ][ Slots ];
+    uint64_t m_occupied[ Levels ][ Words ];
+    long long m_now;
+    size_t m_size;
+    size_t m_cursor;
+
+    // Where the earliest value is, found again only when it may have moved
+    mutable bool m_located;
+    mutable int m_topLevel;
+    mutable int m_topSlot;
+    mutable size_t m_topIndex;
+};
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Default constructor for an empty wheel at time 0.
+ */
+template <typename T>
+TimingWheel<T>::TimingWheel()
+    :   m_now( 0 ), m_size( 0 ), m_cursor( 0 ), m_located( false ),
+        m_topLevel( 0 ), m_topSlot( 0 ), m_topIndex( 0 )
+{
+    for( int level = 0; level < Levels; level++ )
+    {
+        for( int word = 0; word < Words; word++ )
+            m_occupied[ level ][ word ] = 0;
+    }
+}
+
+//
+// QUEUE OPERATIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Adds a value, its time must not be earlier than the last value
+ * popped.
+ *
+ * @param[in]  value  The value.
+ */
+template <typename T>
+void TimingWheel<T>::push( const T& value )
+{
+    place( value );
+    m_size++;
+
+    // The earliest value only changes if this one comes before it
+    if( m_located && top() < value )
+    {
+        int level = 0;
+        unsigned long long differs = static_cast<unsigned long long>(
+            value.Time ^ m_now );
+        if( differs != 0 )
+            level = ( 63 - __builtin_clzll( differs ) ) / Bits;
+
+        m_topLevel = level;
+        m_topSlot = slotOf( value.Time, level );
+        m_topIndex = m_slots[ m_topLevel ][ m_topSlot ].size() - 1;
+    }
+}
+
+/**
+ * @brief      The earliest value, the wheel must not be empty.
+ *
+ * @return     The value that pop() removes next.
+ */
+template <typename T>
+const T& TimingWheel<T>::top() const
+{
+    if( !m_located )
+        locate();
+    return m_slots[ m_topLevel ][ m_topSlot ][ m_topIndex ];
+}
+
+/**
+ * @brief      Removes the earliest value and advances the wheel to its time,
+ * the wheel must not be empty.
+ */
+template <typename T>
+void TimingWheel<T>::pop()
+{
+    if( !m_located )
+        locate();
+    m_located = false;
+    m_size--;
+
+    std::vector<T>& slot = m_slots[ m_topLevel ][ m_topSlot ];
+    int current = slotOf( m_now, 0 );
+
+    if( m_topLevel == 0 )
+    {
+        // Level 0 slots hold a single time in push order
+        if( m_topSlot != current )
+        {
+            m_now = slot[ 0 ].Time;
+            m_cursor = 0;
+        }
+        m_cursor++;
+
+        if( m_cursor == slot.size() )
+        {
+            slot.clear();
+            m_occupied[ 0 ][ m_topSlot / 64 ] &=
+                ~( 1ULL << ( m_topSlot % 64 ) );
+            m_cursor = 0;
+        }
+        return;
+    }
+
+    // Cascade the slot into the lower levels around the popped time, the
+    // remaining values keep their push order
+    std::vector<T> cascading;
+    cascading.swap( slot );
+    m_occupied[ m_topLevel ][ m_topSlot / 64 ] &=
+        ~( 1ULL << ( m_topSlot % 64 ) );
+    m_now = cascading[ m_topIndex ].Time;
+    m_cursor = 0;
+
+    for( size_t index = 0; index < cascading.size(); index++ )
+    {
+        if( index != m_topIndex )
+            place( cascading[ index ] );
+    }
+
+    // Keep the slot's storage for the next values that land in it
+    cascading.clear();
+    slot.swap( cascading );
+}
+
+/**
+ * @brief      Whether the wheel holds no values.
+ *
+ * @return     True if the wheel is empty, false otherwise.
+ */
+template <typename T>
+bool TimingWheel<T>::empty() const
+{
+    return m_size == 0;
+}
+
+/**
+ * @brief      The number of values in the wheel.
+ *
+ * @return     The number of values.
+ */
+template <typename T>
+size_t TimingWheel<T>::size() const
+{
+    return m_size;
+}
+
+//
+// HELPER FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Appends a value to the slot of its time relative to the
+ * wheel's time.
+ *
+ * @param[in]  value  The value.
+ */
+template <typename T>
+void TimingWheel<T>::place( const T& value )
+{
+    int level = 0;
+    unsigned long long differs = static_cast<unsigned long long>(
+        value.Time ^ m_now );
+    if( differs != 0 )
+        level = ( 63 - __builtin_clzll( differs ) ) / Bits;
+
+    int slot = slotOf( value.Time, level );
+    m_slots[ level ][ slot ].push_back( value );
+    m_occupied[ level ][ slot / 64 ] |= 1ULL << ( slot % 64 );
+}
+
+/**
+ * @brief      Finds the earliest value, the wheel must not be empty.
+ * @details    The first occupied level 0 slot holds it at its front. Failing
+ * that, it is somewhere in the first occupied slot of the lowest occupied
+ * level, which is searched.
+ */
+template <typename T>
+void TimingWheel<T>::locate() const
+{
+    m_located = true;
+
+    int slot = nextSlot( 0, slotOf( m_now, 0 ) );
+    if( slot >= 0 )
+    {
+        m_topLevel = 0;
+        m_topSlot = slot;
+        m_topIndex = slot == slotOf( m_now, 0 ) ? m_cursor : 0;
+        return;
+    }
+
+    for( int level = 1; level < Levels; level++ )
+    {
+        slot = nextSlot( level, slotOf( m_now, level ) + 1 );
+        if( slot < 0 )
+            continue;
+
+        const std::vector<T>& values = m_slots[ level ][ slot ];
+        size_t earliest = 0;
+        for( size_t index = 1; index < values.size(); index++ )
+        {
+            if( values[ earliest ] < values[ index ] )
+                earliest = index;
+        }
+
+        m_topLevel = level;
+        m_topSlot = slot;
+        m_topIndex = earliest;
+        return;
+    }
+}
+
+/**
+ * @brief      Finds the first occupied slot of a level at or after a slot.
+ *
+ * @param[in]  level  The level.
+ * @param[in]  from   The first slot to consider.
+ *
+ * @return     The slot, or -1 if every slot from there on is empty.
+ */
+template <typename T>
+int TimingWheel<T>::nextSlot( int level, int from ) const
+{
+    for( int word = from / 64; word < Words; word++ )
+    {
+        uint64_t bits = m_occupied[ level ][ word ];
+        if( word == from / 64 )
+            bits &= ~0ULL << ( from % 64 );
+        if( bits != 0 )
+            return word * 64 + __builtin_ctzll( bits );
+    }
+    return -1;
+}
+
+/**
+ * @brief      The slot a time falls in on a level.
+ *
+ * @param[in]  time   The time in ms.
+ * @param[in]  level  The level.
+ *
+ * @return     The slot.
+ */
+template <typename T>
+int TimingWheel<T>::slotOf( long long time, int level ) const
+{
+    return static_cast<int>( ( static_cast<unsigned long long>( time ) >>
+        ( level * Bits ) ) & ( Slots - 1 ) );
+}
+
+#endif  //  TIMINGWHEEL_H
@@ -0,0 +1,116 @@
+#include "workers.h"
+
+//
+// CONSTRUCTORS ////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Starts the host threads, which wait until they are given a task.
+ *
+ * @param[in]  threads  The number of threads including the caller's.
+ */
+Workers::Workers( int threads )
+    :   m_threads( threads < 1 ? 1 : threads ), m_task( nullptr ),
+        m_count( 0 ), m_generation( 0 ), m_pending( 0 ), m_stopping( false )
+{
+    for( int worker = 1; worker < m_threads; worker++ )
+        m_pool.push_back( std::thread( &Workers::work, this, worker ) );
+}
+
+/**
+ * @brief      Stops and joins every host thread.
+ */
+Workers::~Workers()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_stopping = true;
+    }
+    m_started.notify_all();
+
+    for( size_t thread = 0; thread < m_pool.size(); thread++ )
+        m_pool[ thread ].join();
+}
+
+//
+// TASKS ///////////////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      Runs the task for every index in [0, count) and returns once
+ * all of them are done.
+ * @details    Index i always runs on worker i % size(), so a task that only
+ * touches the state of its own index needs no locking.
+ *
+ * @param[in]  count  The number of indices.
+ * @param[in]  task   The task to run for each index.
+ */
+void Workers::run( int count, const std::function<void( int )>& task )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_task = &task;
+        m_count = count;
+        m_pending = m_threads - 1;
+        m_generation++;
+    }
+    m_started.notify_all();
+
+    runShare( 0 );
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_finished.wait( lock, [this]{ return m_pending == 0; } );
+    m_task = nullptr;
+}
+
+/**
+ * @brief      Get the number of threads, including the caller's.
+ *
+ * @return     The number of workers.
+ */
+int Workers::size() const
+{
+    return m_threads;
+}
+
+//
+// HELPER FUNCTIONS ////////////////////////////////////////////////////////////
+//
+
+/**
+ * @brief      The loop of every host thread other than the caller's.
+ *
+ * @param[in]  worker  The index of this worker.
+ */
+void Workers::work( int worker )
+{
+    long long generation = 0;
+    while( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_started.wait( lock, [this, generation]{
+                return m_stopping || m_generation != generation; } );
+            if( m_stopping )
+                return;
+            generation = m_generation;
+        }
+
+        runShare( worker );
+
+        std::lock_guard<std::mutex> lock( m_mutex );
+        if( --m_pending == 0 )
+            m_finished.notify_one();
+    }
+}
+
+/**
+ * @brief      Runs the task for every index assigned to a worker.
+ *
+ * @param[in]  worker  The index of the worker.
+ */
+void Workers::runShare( int worker )
+{
+    for( int index = worker; index < m_count; index += m_threads )
+        ( *m_task )( index );
+}
@@ -0,0 +1,42 @@
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief      A fixed set of host threads that repeatedly run a task over a
+ * range of indices, the calling thread takes part as the first worker.
+ */
+class Workers
+{
+public:
+    explicit Workers( int threads );
+    ~Workers();
+
+    void run( int count, const std::function<void( int )>& task );
+    int size() const;
+
+    Workers( const Workers& ) = delete;
+    Workers& operator=( const Workers& ) = delete;
+
+private:
+    void work( int worker );
+    void runShare( int worker );
+
+    int m_threads;
+    std::vector<std::thread> m_pool;
+    std::mutex m_mutex;
+    std::condition_variable m_started;
+    std::condition_variable m_finished;
+    const std::function<void( int )>* m_task;
+    int m_count;
+    long long m_generation;
+    int m_pending;
+    bool m_stopping;
+};
+
+#endif  //  WORKERS_H
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <utility>
 
 #include "Tools/log.h"
 #include "Tools/timer.h"
@@ -42,19 +43,23 @@ int main( int argc, char** argv )
         //Load config into a string, parse, and put the data into a class
         Config config;
         std::string configFile = Parser::loadData( argv[1] );
-        Parser::parseConfig( configFile, config );
+        if( !( Parser::parseConfig( configFile, config ) ) )
+        {
+            std::cout << "WARNING: Invalid config file." << std::endl;
+            return EXIT_FAILURE;
+        }
 
         //Set the logger class' configuration
         logger.setConfig( config );
 
         //Parse every meta-data operation into a list
-        std::string metadata = Parser::loadData( config.filePath );
-        std::list<std::string> operations = Parser::splitMetaData( metadata );
-        
+        std::list<std::string> operations = Parser::splitMetaData(
+            Parser::loadData( config.filePath ) );
+
         //Begin the simulator by giving it the requested configuration &
         //All the operations found in the file specified
         logger << Timer::msDT() << " - Simulator " << "START" << "\n";
-        Simulator sim( config, operations );
+        Simulator sim( config, std::move( operations ) );
         sim.start();
         logger << Timer::msDT() << " - Simulator " << "END" << "\n";
         
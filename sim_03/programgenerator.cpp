@@ -1,251 +1,176 @@
-// header files
-#include <iostream>
-#include <fstream>
-#include <cstdlib>
-#include <ctime>
-#include <cstring>
-#include <ctime>
-
-using namespace std;
-
-// global constants
-
-   const int STD_STR_LEN = 45;
-   const int MAX_LINE_LENGTH = 55;
-   const int OPTIME_MAX = 15;
-   const int OPTIME_MIN = 5;
-   const char NULL_CHAR = '\0';
-
-// function prototypes
-
-void getNewOp( int percent, char opStr[] );
-bool getOdds( int oddPercent );
-int getRandBetween( int low, int high );
-int checkLineLength( char str[], int startLen, ofstream &outF );
-int intToString( int value, char valStr[], int index );
-
-// main program
-int main()
-   {
-    // initialize program
-
-       // initialize variables
-       int procPercentage, numOps, numPrograms;
-       int progCtr, opCtr, lineLength = 0;
-       char fileName[ STD_STR_LEN ];
-       ofstream outFileObject;
-       char opString[ STD_STR_LEN ];
-       char tempString[ STD_STR_LEN ];
-
-       // initialize random generator
-       srand( time( NULL ) );
-
-       // show title
-       cout << "Program Meta-Data Creation Program" 
-            << endl << endl;
-
-    // get file name for meta-data file
-    cout << "Enter file name to use: ";
-    cin >> fileName;
-
-    // get weight of processing
-    cout << "Enter percentage of processing: ";
-    cin >> procPercentage;
-
-    // get number of actions
-    cout << "Enter number of operations per program: ";
-    cin >> numOps;
-
-    // get number of programs to generate
-    cout << "Enter number of programs: ";
-    cin >> numPrograms;
-
-    // open file
-    outFileObject.open( fileName );
-
-    // output file description header
-    outFileObject << "Start Program Meta-Data Code:" << endl;
-
-    // set temporary string with string literal
-    strcpy( tempString, "S(start)0; " );
-
-    // output Operating System start
-    outFileObject << tempString;
-   
-    // update length, output end of line as needed
-    lineLength = checkLineLength( tempString, lineLength, outFileObject );
-
-    // loop across number of programs
-    for( progCtr = 0; progCtr < numPrograms; progCtr++ )
-       {
-        // set temporary string with string literal
-        strcpy( tempString, "A(start)0; " );
-    
-        // update length, output end of line as needed
-        lineLength = checkLineLength( tempString, lineLength, outFileObject );
-
-        // show begin of program
-        outFileObject << tempString;
-
-        // loop across number of operations
-        for( opCtr = 0; opCtr < numOps; opCtr++ )
-           {
-            // get new op
-            getNewOp( procPercentage, opString );
-
-            // update length, output end of line as needed
-            lineLength = checkLineLength( opString, lineLength, outFileObject );
-
-            // output new op
-            outFileObject << opString;
-           }
-        // end loop across number of operations
-
-        // set temporary string with string literal
-        strcpy( tempString, "A(end)0; " );
-
-        // update length, output end of line as needed
-        lineLength = checkLineLength( tempString, lineLength, outFileObject );
-
-        // add end of program
-        outFileObject << tempString;
-       }
-    // end number of programs loop
-
-    // set temporary string with string literal
-    strcpy( tempString, "S(end)0." );
-
-    // update length, output end of line as needed
-    lineLength = checkLineLength( tempString, lineLength, outFileObject );
-
-    // output end of operating system
-    outFileObject << tempString;
-
-    // output extra endline        
-    outFileObject << endl;
-
-    // output file description header
-    outFileObject << "End Program Meta-Data Code." << endl;
-
-    // close file
-    outFileObject.close();
-
-    // shut down program
-
-       // return success
-       return 0; 
-   }
-
-// supporting function implementations
-
-int getRandBetween( int low, int high )
-   {
-    int range = high - low + 1;
-
-    return rand() % range + low;    
-   }
-
-bool getOdds( int oddPercent )
-   {
-    int randVal = rand() % 100 + 1;
-
-    if( randVal <= oddPercent )
-       {
-        return true;
-       }
-
-    return false;
-   }
-
-void getNewOp( int percent, char opStr[] )
-   {
-    int cycleNum, recStartIndex = 0;
-    char numStr[ STD_STR_LEN ];
-    static int ioOpVal = 0;
-
-    // check for chance of processing
-    if( getOdds( percent ) )
-       {
-        strcpy( opStr, "P(run)" );
-       }
-
-    else
-       {
-        if( ioOpVal == 0 ) // input process
-           {
-            if( getOdds( 50 ) ) // toss coin
-               {
-                strcpy( opStr, "I(hard drive)" );
-               }
-            else
-               {
-                strcpy( opStr, "I(keyboard)" );
-               }
-
-            ioOpVal = 1;
-           }
-        else
-           {
-            if( getOdds( 33 ) ) // toss coin
-               {
-                strcpy( opStr, "O(hard drive)" );
-               }
-            else if( getOdds( 33 ) )
-               {
-                strcpy( opStr, "O(monitor)" );
-               }
-            else
-               {
-                strcpy( opStr, "O(printer)" );
-               }
-
-            ioOpVal = 0;
-           }
-       }
-
-    cycleNum = getRandBetween( OPTIME_MIN, OPTIME_MAX );
-
-    intToString( cycleNum, numStr, recStartIndex );
-
-    strcat( opStr, numStr );
-
-    strcat( opStr, "; " );
-   }
-
-int checkLineLength( char str[], int startLen, ofstream &outF )
-   {
-    int newLength = startLen + strlen( str );
-
-    if( newLength > MAX_LINE_LENGTH )
-       {
-        outF << endl;
-
-        return 0;
-       }
-
-    return newLength;
-   }
-
-int intToString( int value, char valStr[], int index )
-   {
-    char digit;
-
-    // check for digits remaining
-    if( value > 0 )
-       {
-        digit = char( value % 10 + '0' );
-
-        index = intToString( value / 10, valStr, index + 1 );
-       }
-    else
-       {
-        valStr[ index ] = NULL_CHAR;
-
-        return 0;
-       }
-
-    valStr[ index ] = digit;
-
-    return index + 1;
-   }
-
+/**
+ * @file     programgenerator.cpp
+ * @brief    Generates a meta-data (.mdf) file of seeded random programs.
+ *
+ * @details  Usage: ./programgenerator file processing% operations programs
+ * [seed] [threads] [--profile name] [--bursts name] [--arrival msec]
+ * Every argument is given on the command line so that workloads can be
+ * generated by scripts, and the same arguments always generate the same file,
+ * whatever the number of threads. The file may be "-" to write to the standard
+ * output. The seed defaults to 1 and the threads to one per hardware thread.
+ *
+ * The profile is "Uniform" (the default, which uses the processing
+ * percentage), "CPU-bound", "I/O-bound", "Interactive" or "Mixed". The bursts
+ * are "Uniform" (the default), "Pareto" or "Lognormal". A mean arrival time
+ * in ms makes programs arrive as a Poisson process, see generator.h.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "Tools/generator.h"
+
+/**
+ * @brief      Reads a whole number argument.
+ *
+ * @param[in]  text     The argument.
+ * @param[in]  minimum  The smallest value allowed.
+ * @param[out] value    The number.
+ *
+ * @return     True if the argument is a whole number of at least the minimum,
+ * false otherwise.
+ */
+bool readNumber( const char* text, long long minimum, long long& value )
+{
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoll( text, &end, 10 );
+    return end != text && *end == '\0' && errno == 0 && value >= minimum;
+}
+
+/**
+ * @brief      Reads the workload's options from the command line.
+ *
+ * @param[in]  argc     The number of command line arguments.
+ * @param      argv     The command line arguments, see the usage above.
+ * @param[out] options  The options.
+ *
+ * @return     True if every argument is valid, false otherwise.
+ */
+bool readOptions( int argc, char** argv, GeneratorOptions& options )
+{
+    long long percent, operations, programs, number;
+    if( argc < 5 ||
+        !( readNumber( argv[ 2 ], 0, percent ) ) || percent > 100 ||
+        !( readNumber( argv[ 3 ], 0, operations ) ) || operations > 1000000 ||
+        !( readNumber( argv[ 4 ], 0, programs ) ) )
+    {
+        return false;
+    }
+    options.processingPercent = static_cast<int>( percent );
+    options.operations = static_cast<int>( operations );
+    options.programs = programs;
+    options.threads = std::max( 1U, std::thread::hardware_concurrency() );
+
+    // The seed and threads are given in order, options by name in any order
+    int position = 0;
+    for( int index = 5; index < argc; index++ )
+    {
+        std::string argument = argv[ index ];
+        bool named = index + 1 < argc;
+        if( argument == "--profile" && named )
+        {
+            options.profile = argv[ ++index ];
+            if( !( Generator::hasProfile( options.profile ) ) )
+                return false;
+        }
+        else if( argument == "--bursts" && named )
+        {
+            options.bursts = argv[ ++index ];
+            if( !( Generator::hasBursts( options.bursts ) ) )
+                return false;
+        }
+        else if( argument == "--arrival" && named )
+        {
+            if( !( readNumber( argv[ ++index ], 0, number ) ) || 
+                number > 1000000 )
+            {
+                return false;
+            }
+            options.meanArrival = static_cast<int>( number );
+        }
+        else if( position == 0 && readNumber( argv[ index ], 0, number ) )
+        {
+            options.seed = static_cast<uint64_t>( number );
+            position++;
+        }
+        else if( position == 1 && readNumber( argv[ index ], 1, number ) &&
+            number <= 256 )
+        {
+            options.threads = static_cast<int>( number );
+            position++;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief      Main program loop.
+ *
+ * @param[in]  argc  The number of command line arguments.
+ * @param      argv  The command line arguments, see the usage above.
+ *
+ * @return     EXIT_SUCCESS if the file was written, EXIT_FAILURE otherwise.
+ */
+int main( int argc, char** argv )
+{
+    GeneratorOptions options;
+    if( !( readOptions( argc, argv, options ) ) )
+    {
+        std::cout << "WARNING: Invalid arguments." << std::endl;
+        std::cout << "Ex: ./programgenerator file.mdf 50 10 1000 [seed] "
+            << "[threads] [--profile Mixed] [--bursts Pareto] [--arrival 20]"
+            << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string path = argv[ 1 ];
+    std::ofstream file;
+    if( path != "-" )
+    {
+        file.open( path.c_str(), std::ios::binary );
+        if( !( file.is_open() ) )
+        {
+            std::cout << "WARNING: File could not be opened." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    std::ostream& stream = path == "-" ? std::cout : file;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    Generator generator( options );
+    generator.write( stream );
+    stream.flush();
+    if( !( stream ) )
+    {
+        std::cout << "WARNING: File could not be written." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Report the throughput, unless the workload itself went to the output
+    if( path != "-" )
+    {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        double megabytes = static_cast<double>( file.tellp() ) / 1e6;
+        std::cout << "Wrote " << options.programs << " programs of " 
+            << options.operations << " operations on " << options.threads 
+            << " threads, " << megabytes
+            << " MB in " << elapsed.count()
+            << " s (" << megabytes / elapsed.count() << " MB/s)" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}